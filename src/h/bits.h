@@ -0,0 +1,224 @@
+/*
+** bits.h | The Sol Vector Library | Bitwise operations for integer vectors.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_BITS_H
+#define SOL_BITS_H
+
+/*
+** Convenience Macros
+**
+** Left shifts and the right half of a rotate go through `U`, the unsigned
+** vector of the same shape (or `UT`, its lane type), so they never shift a
+** negative value; `V_shr` stays in `V`, so it is arithmetic for signed lanes.
+** The `F` forms shift every lane by the same scalar count, which the compiler
+** can turn into a single `psll`/`psrl`/`psra` even without AVX2.
+*/
+
+#ifdef SOL_GNU
+  #define BITS_OP(T, UT, U, V, O, A, OP, B) O = A OP B
+  #define BITS_SHL(T, UT, U, V, O, A, B) O = (V) ((U) A << (U) B)
+  #define BITS_SHRU(T, UT, U, V, O, A, B) O = (V) ((U) A >> (U) B)
+  #define BITS_OPF(T, UT, U, V, O, A, OP, N) O = A OP N
+  #define BITS_SHLF(T, UT, U, V, O, A, N) O = (V) ((U) A << N)
+  #define BITS_SHRUF(T, UT, U, V, O, A, N) O = (V) ((U) A >> N)
+#else
+  #define BITS_OP(T, UT, U, V, O, A, OP, B)            \
+    for (size_t i = 0; i < sizeof(O) / sizeof(T); i++) \
+      vec(O)[i] = (T) (vec(A)[i] OP vec(B)[i])
+  #define BITS_SHL(T, UT, U, V, O, A, B)               \
+    for (size_t i = 0; i < sizeof(O) / sizeof(T); i++) \
+      vec(O)[i] = (T) ((UT) vec(A)[i] << vec(B)[i])
+  #define BITS_SHRU(T, UT, U, V, O, A, B)              \
+    for (size_t i = 0; i < sizeof(O) / sizeof(T); i++) \
+      vec(O)[i] = (T) ((UT) vec(A)[i] >> vec(B)[i])
+  #define BITS_OPF(T, UT, U, V, O, A, OP, N)           \
+    for (size_t i = 0; i < sizeof(O) / sizeof(T); i++) \
+      vec(O)[i] = (T) (vec(A)[i] OP N)
+  #define BITS_SHLF(T, UT, U, V, O, A, N)              \
+    for (size_t i = 0; i < sizeof(O) / sizeof(T); i++) \
+      vec(O)[i] = (T) ((UT) vec(A)[i] << N)
+  #define BITS_SHRUF(T, UT, U, V, O, A, N)             \
+    for (size_t i = 0; i < sizeof(O) / sizeof(T); i++) \
+      vec(O)[i] = (T) ((UT) vec(A)[i] >> N)
+#endif
+
+/*
+** Definer Macros
+**
+** Shift counts must be below the lane width, as with scalar shifts. Rotate
+** counts are taken modulo the lane width, so any count is fine.
+*/
+
+#define BITS(T, V, UT, U) \
+\
+/* Logic */ \
+\
+_sol_ \
+V V##_and(V a, V b) {                 \
+  V out;                              \
+  BITS_OP(T, UT, U, V, out, a, &, b); \
+  return out;                         \
+}                                     \
+\
+_sol_ \
+V V##_or(V a, V b) {                  \
+  V out;                              \
+  BITS_OP(T, UT, U, V, out, a, |, b); \
+  return out;                         \
+}                                     \
+\
+_sol_ \
+V V##_xor(V a, V b) {                 \
+  V out;                              \
+  BITS_OP(T, UT, U, V, out, a, ^, b); \
+  return out;                         \
+}                                     \
+\
+_sol_ \
+V V##_not(V v) {                       \
+  return V##_xor(v, V##_setf((T) -1)); \
+}                                      \
+\
+_sol_ \
+V V##_andnot(V a, V b) {         \
+  return V##_and(a, V##_not(b)); \
+}                                \
+\
+/* Shifts */ \
+\
+_sol_ \
+V V##_shl(V a, V b) {               \
+  V out;                            \
+  BITS_SHL(T, UT, U, V, out, a, b); \
+  return out;                       \
+}                                   \
+\
+_sol_ \
+V V##_shr(V a, V b) {                  \
+  V out;                               \
+  BITS_OP(T, UT, U, V, out, a, >>, b); \
+  return out;                          \
+}                                      \
+\
+_sol_ \
+V V##_shlf(V v, int k) {             \
+  V out;                             \
+  BITS_SHLF(T, UT, U, V, out, v, k); \
+  return out;                        \
+}                                    \
+\
+_sol_ \
+V V##_shrf(V v, int k) {                \
+  V out;                                \
+  BITS_OPF(T, UT, U, V, out, v, >>, k); \
+  return out;                           \
+}                                       \
+\
+/* Rotates */ \
+\
+_sol_ \
+V V##_rotl(V a, V b) {                           \
+  const V m = V##_setf((T) (8 * sizeof(T) - 1)); \
+  const V l = V##_and(b, m);                     \
+  const V r = V##_and(V##_fsub(0, b), m);        \
+  V hi, lo;                                      \
+  BITS_SHL(T, UT, U, V, hi, a, l);               \
+  BITS_SHRU(T, UT, U, V, lo, a, r);              \
+  return V##_or(hi, lo);                         \
+}                                                \
+\
+_sol_ \
+V V##_rotr(V a, V b) {                \
+  return V##_rotl(a, V##_fsub(0, b)); \
+}                                     \
+\
+_sol_ \
+V V##_rotlf(V v, int k) {                       \
+  const int l = k & (int) (8 * sizeof(T) - 1);  \
+  const int r = -k & (int) (8 * sizeof(T) - 1); \
+  V hi, lo;                                     \
+  BITS_SHLF(T, UT, U, V, hi, v, l);             \
+  BITS_SHRUF(T, UT, U, V, lo, v, r);            \
+  return V##_or(hi, lo);                        \
+}                                               \
+\
+_sol_ \
+V V##_rotrf(V v, int k) {  \
+  return V##_rotlf(v, -k); \
+}                          \
+\
+/* Bulk Kernels */ \
+\
+SOL_N2(V##_and, V, V) \
+SOL_N2(V##_or, V, V) \
+SOL_N2(V##_xor, V, V) \
+SOL_N1(V##_not, V, V) \
+SOL_N2(V##_andnot, V, V) \
+SOL_N2(V##_shl, V, V) \
+SOL_N2(V##_shr, V, V) \
+SOL_N2F(V##_shlf, V, V, int, k) \
+SOL_N2F(V##_shrf, V, V, int, k) \
+SOL_N2(V##_rotl, V, V) \
+SOL_N2(V##_rotr, V, V) \
+SOL_N2F(V##_rotlf, V, V, int, k) \
+SOL_N2F(V##_rotrf, V, V, int, k)
+
+BITS(i8, i8x2, u8, u8x2)
+BITS(i8, i8x3, u8, u8x3)
+BITS(i8, i8x4, u8, u8x4)
+BITS(i8, i8x8, u8, u8x8)
+BITS(i8, i8x16, u8, u8x16)
+
+BITS(i16, i16x2, u16, u16x2)
+BITS(i16, i16x3, u16, u16x3)
+BITS(i16, i16x4, u16, u16x4)
+BITS(i16, i16x8, u16, u16x8)
+BITS(i16, i16x16, u16, u16x16)
+
+BITS(i32, i32x2, u32, u32x2)
+BITS(i32, i32x3, u32, u32x3)
+BITS(i32, i32x4, u32, u32x4)
+BITS(i32, i32x8, u32, u32x8)
+BITS(i32, i32x16, u32, u32x16)
+
+BITS(i64, i64x2, u64, u64x2)
+BITS(i64, i64x3, u64, u64x3)
+BITS(i64, i64x4, u64, u64x4)
+BITS(i64, i64x8, u64, u64x8)
+BITS(i64, i64x16, u64, u64x16)
+
+BITS(u8, u8x2, u8, u8x2)
+BITS(u8, u8x3, u8, u8x3)
+BITS(u8, u8x4, u8, u8x4)
+BITS(u8, u8x8, u8, u8x8)
+BITS(u8, u8x16, u8, u8x16)
+
+BITS(u16, u16x2, u16, u16x2)
+BITS(u16, u16x3, u16, u16x3)
+BITS(u16, u16x4, u16, u16x4)
+BITS(u16, u16x8, u16, u16x8)
+BITS(u16, u16x16, u16, u16x16)
+
+BITS(u32, u32x2, u32, u32x2)
+BITS(u32, u32x3, u32, u32x3)
+BITS(u32, u32x4, u32, u32x4)
+BITS(u32, u32x8, u32, u32x8)
+BITS(u32, u32x16, u32, u32x16)
+
+BITS(u64, u64x2, u64, u64x2)
+BITS(u64, u64x3, u64, u64x3)
+BITS(u64, u64x4, u64, u64x4)
+BITS(u64, u64x8, u64, u64x8)
+BITS(u64, u64x16, u64, u64x16)
+
+#undef BITS
+#undef BITS_OP
+#undef BITS_SHL
+#undef BITS_SHRU
+#undef BITS_OPF
+#undef BITS_SHLF
+#undef BITS_SHRUF
+
+#endif /* SOL_BITS_H */
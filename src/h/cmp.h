@@ -0,0 +1,223 @@
+/*
+** cmp.h | The Sol Vector Library | Comparisons, masks and selects for every vector type.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_CMP_H
+#define SOL_CMP_H
+
+/*
+** Convenience Macros
+**
+** A mask `M` has the same lane count and lane width as its `V`, with every
+** lane either all ones (true) or all zeroes (false), which is what GNU vector
+** comparisons already produce. CMP_SEL takes each lane from `A` where the mask
+** is set and from `B` where it is not, by bits rather than by branches.
+*/
+
+#ifdef SOL_GNU
+  #define CMP_REL(I, W, M, O, A, OP, B) O = (M) (A OP B)
+  #define CMP_SEL(V, W, M, O, S, A, B) O = (V) (((M) A & S) | ((M) B & ~S))
+#else
+  #define CMP_REL(I, W, M, O, A, OP, B) \
+    for (size_t i = 0; i < W; i++) vec(O)[i] = (I) -(vec(A)[i] OP vec(B)[i])
+  #define CMP_SEL(V, W, M, O, S, A, B) \
+    for (size_t i = 0; i < W; i++) vec(O)[i] = vec(S)[i] ? vec(A)[i] : vec(B)[i]
+#endif
+
+/*
+** Definer Macros
+**
+** `V_min` and `V_max` return `b` when either lane is NaN, the same as the
+** `minps` and `maxps` instructions.
+*/
+
+#define CMP(V, I, M, W) \
+\
+/* Comparisons */ \
+\
+_sol_ \
+M V##_eq(V a, V b) {               \
+  M out;                           \
+  CMP_REL(I, W, M, out, a, ==, b); \
+  return out;                      \
+}                                  \
+\
+_sol_ \
+M V##_ne(V a, V b) {               \
+  M out;                           \
+  CMP_REL(I, W, M, out, a, !=, b); \
+  return out;                      \
+}                                  \
+\
+_sol_ \
+M V##_lt(V a, V b) {              \
+  M out;                          \
+  CMP_REL(I, W, M, out, a, <, b); \
+  return out;                     \
+}                                 \
+\
+_sol_ \
+M V##_le(V a, V b) {               \
+  M out;                           \
+  CMP_REL(I, W, M, out, a, <=, b); \
+  return out;                      \
+}                                  \
+\
+_sol_ \
+M V##_gt(V a, V b) {              \
+  M out;                          \
+  CMP_REL(I, W, M, out, a, >, b); \
+  return out;                     \
+}                                 \
+\
+_sol_ \
+M V##_ge(V a, V b) {               \
+  M out;                           \
+  CMP_REL(I, W, M, out, a, >=, b); \
+  return out;                      \
+}                                  \
+\
+/* Selection */ \
+\
+_sol_ \
+V V##_select(M m, V a, V b) {     \
+  V out;                          \
+  CMP_SEL(V, W, M, out, m, a, b); \
+  return out;                     \
+}                                 \
+\
+_sol_ \
+V V##_min(V a, V b) {                    \
+  return V##_select(V##_lt(a, b), a, b); \
+}                                        \
+\
+_sol_ \
+V V##_max(V a, V b) {                    \
+  return V##_select(V##_gt(a, b), a, b); \
+}                                        \
+\
+_sol_ \
+V V##_clamp(V v, V lo, V hi) {        \
+  return V##_min(V##_max(v, lo), hi); \
+}                                     \
+\
+/* Bulk Kernels */ \
+\
+SOL_N2(V##_min, V, V) \
+SOL_N2(V##_max, V, V) \
+SOL_N3(V##_clamp, V, V)
+
+/*
+** The reductions only look at the first `W` lanes, so the padding lane of a
+** GNU `Tx3` never counts.
+*/
+
+#define CMP_MASK(I, M, W) \
+\
+_sol_ \
+bool M##_any(M m) {              \
+  I acc = 0;                     \
+  for (size_t i = 0; i < W; i++) \
+    acc |= vec(m)[i];            \
+  return acc != 0;               \
+}                                \
+\
+_sol_ \
+bool M##_all(M m) {              \
+  I acc = -1;                    \
+  for (size_t i = 0; i < W; i++) \
+    acc &= vec(m)[i];            \
+  return acc != 0;               \
+}
+
+CMP(f32x2, i32, i32x2, 2)
+CMP(f32x3, i32, i32x3, 3)
+CMP(f32x4, i32, i32x4, 4)
+CMP(f32x8, i32, i32x8, 8)
+CMP(f32x16, i32, i32x16, 16)
+
+CMP(f64x2, i64, i64x2, 2)
+CMP(f64x3, i64, i64x3, 3)
+CMP(f64x4, i64, i64x4, 4)
+CMP(f64x8, i64, i64x8, 8)
+CMP(f64x16, i64, i64x16, 16)
+
+CMP(i8x2, i8, i8x2, 2)
+CMP(i8x3, i8, i8x3, 3)
+CMP(i8x4, i8, i8x4, 4)
+CMP(i8x8, i8, i8x8, 8)
+CMP(i8x16, i8, i8x16, 16)
+
+CMP(i16x2, i16, i16x2, 2)
+CMP(i16x3, i16, i16x3, 3)
+CMP(i16x4, i16, i16x4, 4)
+CMP(i16x8, i16, i16x8, 8)
+CMP(i16x16, i16, i16x16, 16)
+
+CMP(i32x2, i32, i32x2, 2)
+CMP(i32x3, i32, i32x3, 3)
+CMP(i32x4, i32, i32x4, 4)
+CMP(i32x8, i32, i32x8, 8)
+CMP(i32x16, i32, i32x16, 16)
+
+CMP(i64x2, i64, i64x2, 2)
+CMP(i64x3, i64, i64x3, 3)
+CMP(i64x4, i64, i64x4, 4)
+CMP(i64x8, i64, i64x8, 8)
+CMP(i64x16, i64, i64x16, 16)
+
+CMP(u8x2, i8, i8x2, 2)
+CMP(u8x3, i8, i8x3, 3)
+CMP(u8x4, i8, i8x4, 4)
+CMP(u8x8, i8, i8x8, 8)
+CMP(u8x16, i8, i8x16, 16)
+
+CMP(u16x2, i16, i16x2, 2)
+CMP(u16x3, i16, i16x3, 3)
+CMP(u16x4, i16, i16x4, 4)
+CMP(u16x8, i16, i16x8, 8)
+CMP(u16x16, i16, i16x16, 16)
+
+CMP(u32x2, i32, i32x2, 2)
+CMP(u32x3, i32, i32x3, 3)
+CMP(u32x4, i32, i32x4, 4)
+CMP(u32x8, i32, i32x8, 8)
+CMP(u32x16, i32, i32x16, 16)
+
+CMP(u64x2, i64, i64x2, 2)
+CMP(u64x3, i64, i64x3, 3)
+CMP(u64x4, i64, i64x4, 4)
+CMP(u64x8, i64, i64x8, 8)
+CMP(u64x16, i64, i64x16, 16)
+
+CMP_MASK(i8, i8x2, 2)
+CMP_MASK(i8, i8x3, 3)
+CMP_MASK(i8, i8x4, 4)
+CMP_MASK(i8, i8x8, 8)
+CMP_MASK(i8, i8x16, 16)
+
+CMP_MASK(i16, i16x2, 2)
+CMP_MASK(i16, i16x3, 3)
+CMP_MASK(i16, i16x4, 4)
+CMP_MASK(i16, i16x8, 8)
+CMP_MASK(i16, i16x16, 16)
+
+CMP_MASK(i32, i32x2, 2)
+CMP_MASK(i32, i32x3, 3)
+CMP_MASK(i32, i32x4, 4)
+CMP_MASK(i32, i32x8, 8)
+CMP_MASK(i32, i32x16, 16)
+
+CMP_MASK(i64, i64x2, 2)
+CMP_MASK(i64, i64x3, 3)
+CMP_MASK(i64, i64x4, 4)
+CMP_MASK(i64, i64x8, 8)
+CMP_MASK(i64, i64x16, 16)
+
+#undef CMP
+#undef CMP_MASK
+#undef CMP_REL
+#undef CMP_SEL
+
+#endif /* SOL_CMP_H */
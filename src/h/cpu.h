@@ -0,0 +1,47 @@
+/*
+** cpu.h | The Sol Vector Library | Code for CPU feature dispatch.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_CPU_H
+#define SOL_CPU_H
+
+static int sol_level_cur = -1;
+
+_sol_
+sol_level sol_cpu_level(void) {
+  #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    static int level = -1;
+    if (level < 0) {
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl")
+       && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq"))
+        level = SOL_LEVEL_AVX512;
+      else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        level = SOL_LEVEL_AVX2;
+      else if (__builtin_cpu_supports("avx"))
+        level = SOL_LEVEL_AVX;
+      else
+        level = SOL_LEVEL_BASE;
+    }
+    return (sol_level) level;
+  #else
+    return SOL_LEVEL_BASE;
+  #endif
+}
+
+_sol_
+sol_level sol_level_get(void) {
+  if (sol_level_cur < 0)
+    sol_level_cur = (int) sol_cpu_level();
+  return (sol_level) sol_level_cur;
+}
+
+_sol_
+sol_level sol_level_set(sol_level level) {
+  const sol_level max = sol_cpu_level();
+  sol_level_cur = (int) ((level > max) ? max : level);
+  return (sol_level) sol_level_cur;
+}
+
+#endif /* SOL_CPU_H */
@@ -0,0 +1,362 @@
+/*
+** div.h | The Sol Vector Library | Division by invariant integers.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_DIV_H
+#define SOL_DIV_H
+
+/*
+** Magic Numbers
+**
+** These find the multiplier and shifts for a `bits`-wide divisor, after
+** Granlund and Montgomery for unsigned and Warren's "Hacker's Delight" for
+** signed division. They only run once per divisor, so they favour working at
+** every width over speed.
+**
+** For unsigned `d`, with `l = ceil(log2(d))`, the multiplier is
+** `floor(2^bits * (2^l - d) / d) + 1`, found here by long division since it
+** does not fit in a `u64` product when `bits` is 64.
+*/
+
+_sol_
+void DIV_umagic(u64 d, int bits, u64* mul, int* l) {
+  int k = 0;
+  while (k < bits && ((d - 1) >> k) != 0)
+    k++;
+  u64 rem = ((k == 64) ? 0 : (u64) 1 << k) - d;
+  u64 q = 0;
+  for (int i = 0; i < bits; i++) {
+    const u64 top = rem >> 63;
+    rem <<= 1;
+    q <<= 1;
+    if (top || rem >= d) {
+      rem -= d;
+      q |= 1;
+    }
+  }
+  *mul = q + 1;
+  *l = k;
+}
+
+_sol_
+void DIV_smagic(i64 d, int bits, u64* mul, int* sh) {
+  const u64 mask = (bits == 64) ? ~(u64) 0 : ((u64) 1 << bits) - 1;
+  const u64 two = (u64) 1 << (bits - 1);
+  const u64 ad = (d < 0) ? (u64) 0 - (u64) d : (u64) d;
+  const u64 t = two + (d < 0);
+  const u64 anc = t - 1 - t % ad;
+  int p = bits - 1;
+  u64 q1 = two / anc, r1 = two - q1 * anc;
+  u64 q2 = two / ad, r2 = two - q2 * ad;
+  u64 delta;
+  do {
+    p++;
+    q1 = (2 * q1) & mask;
+    r1 = 2 * r1;
+    if (r1 >= anc) {
+      q1 = (q1 + 1) & mask;
+      r1 -= anc;
+    }
+    q2 = (2 * q2) & mask;
+    r2 = 2 * r2;
+    if (r2 >= ad) {
+      q2 = (q2 + 1) & mask;
+      r2 -= ad;
+    }
+    delta = ad - r2;
+  } while (q1 < delta || (q1 == delta && r1 == 0));
+  const u64 m = (q2 + 1) & mask;
+  *mul = (d < 0) ? ((u64) 0 - m) & mask : m;
+  *sh = p - bits;
+}
+
+/*
+** Convenience Macros
+**
+** DIV_AS reinterprets the bits of `X` as a `B`, which the compiler does with
+** no instructions at all.
+*/
+
+#define DIV_AS(B, O, X) \
+  B O; \
+  memcpy(&O, &X, sizeof O)
+
+#if defined(SOL_GNU) && __has_builtin(__builtin_convertvector)
+  #define DIV_VMULHI32(T, V, VW, O, A, B)                       \
+    O = __builtin_convertvector((__builtin_convertvector(A, VW) \
+                              * __builtin_convertvector(B, VW)) >> 32, V)
+#else
+  #define DIV_VMULHI32(T, V, VW, O, A, B)              \
+    for (size_t i = 0; i < sizeof(V) / sizeof(T); i++) \
+      vec(O)[i] = T##_mulhi(vec(A)[i], vec(B)[i])
+#endif
+
+/*
+** On x86 the 32-bit case can skip the widening: `pmuludq` (or `pmuldq` with
+** SSE4.1) multiplies the even lanes into 64-bit products, so two of them and
+** a blend give the high halves of every lane. DIV_X86_u32 and DIV_X86_i32
+** return early with that when `V` is one register, and are empty otherwise.
+*/
+
+#define DIV_X86_128(M, O, A, B) {                                       \
+  __m128i a_, b_;                                                       \
+  memcpy(&a_, &A, sizeof(A));                                           \
+  memcpy(&b_, &B, sizeof(B));                                           \
+  const __m128i ev = _mm_srli_epi64(M(a_, b_), 32);                     \
+  const __m128i od = M(_mm_srli_epi64(a_, 32), _mm_srli_epi64(b_, 32)); \
+  const __m128i hi = _mm_slli_epi64(_mm_set1_epi32(-1), 32);            \
+  const __m128i r_ = _mm_or_si128(ev, _mm_and_si128(od, hi));           \
+  memcpy(&O, &r_, sizeof(O));                                           \
+  return O;                                                             \
+}
+
+#define DIV_X86_256(M, O, A, B) {                                             \
+  __m256i a_, b_;                                                             \
+  memcpy(&a_, &A, sizeof(A));                                                 \
+  memcpy(&b_, &B, sizeof(B));                                                 \
+  const __m256i ev = _mm256_srli_epi64(M(a_, b_), 32);                        \
+  const __m256i od = M(_mm256_srli_epi64(a_, 32), _mm256_srli_epi64(b_, 32)); \
+  const __m256i hi = _mm256_slli_epi64(_mm256_set1_epi32(-1), 32);            \
+  const __m256i r_ = _mm256_or_si256(ev, _mm256_and_si256(od, hi));           \
+  memcpy(&O, &r_, sizeof(O));                                                 \
+  return O;                                                                   \
+}
+
+#if defined(__AVX2__)
+  #define DIV_X86_u32(V, O, A, B)                               \
+    if (sizeof(V) == 32) DIV_X86_256(_mm256_mul_epu32, O, A, B) \
+    if (sizeof(V) == 16) DIV_X86_128(_mm_mul_epu32, O, A, B)
+  #define DIV_X86_i32(V, O, A, B)                               \
+    if (sizeof(V) == 32) DIV_X86_256(_mm256_mul_epi32, O, A, B) \
+    if (sizeof(V) == 16) DIV_X86_128(_mm_mul_epi32, O, A, B)
+#elif defined(__SSE4_1__)
+  #define DIV_X86_u32(V, O, A, B) \
+    if (sizeof(V) == 16) DIV_X86_128(_mm_mul_epu32, O, A, B)
+  #define DIV_X86_i32(V, O, A, B) \
+    if (sizeof(V) == 16) DIV_X86_128(_mm_mul_epi32, O, A, B)
+#elif defined(__SSE2__)
+  #define DIV_X86_u32(V, O, A, B) \
+    if (sizeof(V) == 16) DIV_X86_128(_mm_mul_epu32, O, A, B)
+  #define DIV_X86_i32(V, O, A, B)
+#else
+  #define DIV_X86_u32(V, O, A, B)
+  #define DIV_X86_i32(V, O, A, B)
+#endif
+
+/*
+** Definer Macros
+**
+** `V_mulhi` for 32-bit lanes multiplies in 64-bit lanes and keeps the top
+** half. 64-bit lanes have nothing wider, so they take the same four partial
+** products as `u64_mulhi` and, when `S` is set, the same signed correction
+** as `i64_mulhi`; `U` is the unsigned vector of the same shape.
+*/
+
+#define DIV_MULHI32(T, V, VW) \
+_sol_ \
+V V##_mulhi(V a, V b) {              \
+  V out;                             \
+  DIV_X86_##T(V, out, a, b)          \
+  DIV_VMULHI32(T, V, VW, out, a, b); \
+  return out;                        \
+}
+
+#define DIV_MULHI64(V, U, S) \
+_sol_ \
+V V##_mulhi(V a, V b) {                                              \
+  DIV_AS(U, ua, a);                                                  \
+  DIV_AS(U, ub, b);                                                  \
+  const U lo = U##_setf(0xffffffff);                                 \
+  const U a0 = U##_and(ua, lo), a1 = U##_shrf(ua, 32);               \
+  const U b0 = U##_and(ub, lo), b1 = U##_shrf(ub, 32);               \
+  const U p10 = U##_mul(a1, b0);                                     \
+  const U mid = U##_add(U##_add(U##_shrf(U##_mul(a0, b0), 32),       \
+                                U##_and(p10, lo)), U##_mul(a0, b1)); \
+  U hi = U##_add(U##_add(U##_mul(a1, b1), U##_shrf(p10, 32)),        \
+                 U##_shrf(mid, 32));                                 \
+  if (S) {                                                           \
+    const V sa = V##_shrf(a, 63), sb = V##_shrf(b, 63);              \
+    DIV_AS(U, ma, sa);                                               \
+    DIV_AS(U, mb, sb);                                               \
+    hi = U##_sub(U##_sub(hi, U##_and(ub, ma)), U##_and(ua, mb));     \
+  }                                                                  \
+  DIV_AS(V, out, hi);                                                \
+  return out;                                                        \
+}
+
+/*
+** `Tdiv_set(d)` takes any nonzero `d`. Unsigned quotients come from
+** `t = ((n - q) >> sh1) + q` and `t >> sh2`, where `q` is the high half of
+** `n * mul`, which never overflows. Signed ones add or subtract `n` where the
+** multiplier's sign is wrong (in `U`, the unsigned type, so that it wraps),
+** shift, and round towards zero by adding one to negative results; `fix`
+** turns that off for `d` of 1 and -1, which have no multiplier.
+*/
+
+#define DIV_U(T, D) \
+\
+_sol_ \
+D D##_set(T d) {                          \
+  D out;                                  \
+  u64 mul;                                \
+  int l;                                  \
+  DIV_umagic(d, 8 * sizeof(T), &mul, &l); \
+  out.mul = (T) mul;                      \
+  out.sh1 = (l > 0) ? 1 : 0;              \
+  out.sh2 = (l > 0) ? l - 1 : 0;          \
+  return out;                             \
+}                                         \
+\
+_sol_ \
+T T##_div_by(T n, D d) {                                  \
+  const T q = T##_mulhi(n, d.mul);                        \
+  return (T) ((T) (((T) (n - q) >> d.sh1) + q) >> d.sh2); \
+}
+
+#define DIV_S(T, D, U) \
+\
+_sol_ \
+D D##_set(T d) {                                          \
+  D out;                                                  \
+  u64 mul = 0;                                            \
+  int sh = 0;                                             \
+  if (d != 1 && d != -1)                                  \
+    DIV_smagic(d, 8 * sizeof(T), &mul, &sh);              \
+  out.mul = (T) mul;                                      \
+  out.add = (d == 1 || (d > 0 && out.mul < 0)) ? -1 : 0;  \
+  out.sub = (d == -1 || (d < 0 && out.mul > 0)) ? -1 : 0; \
+  out.fix = (d != 1 && d != -1) ? -1 : 0;                 \
+  out.sh = sh;                                            \
+  return out;                                             \
+}                                                         \
+\
+_sol_ \
+T T##_div_by(T n, D d) {                                 \
+  const U fix = (U) (n & d.add) - (U) (n & d.sub);       \
+  T q = (T) ((U) T##_mulhi(n, d.mul) + fix);             \
+  q = (T) (q >> d.sh);                                   \
+  return (T) (q - ((q >> (8 * sizeof(T) - 1)) & d.fix)); \
+}
+
+#define DIV_UV(T, V, D) \
+\
+_sol_ \
+V V##_div_by(V v, D d) {                                  \
+  const V q = V##_mulhi(v, V##_setf(d.mul));              \
+  const V t = V##_add(V##_shrf(V##_sub(v, q), d.sh1), q); \
+  return V##_shrf(t, d.sh2);                              \
+}                                                         \
+\
+SOL_N2F(V##_div_by, V, V, D, d)
+
+#define DIV_SV(T, V, D) \
+\
+_sol_ \
+V V##_div_by(V v, D d) {                                          \
+  const V fix = V##_and(v, V##_setf(d.add));                      \
+  const V q = V##_add(V##_mulhi(v, V##_setf(d.mul)),              \
+                      V##_sub(fix, V##_and(v, V##_setf(d.sub)))); \
+  const V t = V##_shrf(q, d.sh);                                  \
+  return V##_sub(t, V##_and(V##_shrf(t, 8 * sizeof(T) - 1),       \
+                            V##_setf(d.fix)));                    \
+}                                                                 \
+\
+SOL_N2F(V##_div_by, V, V, D, d)
+
+DIV_MULHI32(i32, i32x2, i64x2)
+DIV_MULHI32(i32, i32x3, i64x3)
+DIV_MULHI32(i32, i32x4, i64x4)
+DIV_MULHI32(i32, i32x8, i64x8)
+DIV_MULHI32(i32, i32x16, i64x16)
+
+DIV_MULHI32(u32, u32x2, u64x2)
+DIV_MULHI32(u32, u32x3, u64x3)
+DIV_MULHI32(u32, u32x4, u64x4)
+DIV_MULHI32(u32, u32x8, u64x8)
+DIV_MULHI32(u32, u32x16, u64x16)
+
+DIV_MULHI64(i64x2, u64x2, 1)
+DIV_MULHI64(i64x3, u64x3, 1)
+DIV_MULHI64(i64x4, u64x4, 1)
+DIV_MULHI64(i64x8, u64x8, 1)
+DIV_MULHI64(i64x16, u64x16, 1)
+
+DIV_MULHI64(u64x2, u64x2, 0)
+DIV_MULHI64(u64x3, u64x3, 0)
+DIV_MULHI64(u64x4, u64x4, 0)
+DIV_MULHI64(u64x8, u64x8, 0)
+DIV_MULHI64(u64x16, u64x16, 0)
+
+DIV_S(i8, i8div, u8)
+DIV_S(i16, i16div, u16)
+DIV_S(i32, i32div, u32)
+DIV_S(i64, i64div, u64)
+
+DIV_U(u8, u8div)
+DIV_U(u16, u16div)
+DIV_U(u32, u32div)
+DIV_U(u64, u64div)
+
+DIV_SV(i8, i8x2, i8div)
+DIV_SV(i8, i8x3, i8div)
+DIV_SV(i8, i8x4, i8div)
+DIV_SV(i8, i8x8, i8div)
+DIV_SV(i8, i8x16, i8div)
+
+DIV_SV(i16, i16x2, i16div)
+DIV_SV(i16, i16x3, i16div)
+DIV_SV(i16, i16x4, i16div)
+DIV_SV(i16, i16x8, i16div)
+DIV_SV(i16, i16x16, i16div)
+
+DIV_SV(i32, i32x2, i32div)
+DIV_SV(i32, i32x3, i32div)
+DIV_SV(i32, i32x4, i32div)
+DIV_SV(i32, i32x8, i32div)
+DIV_SV(i32, i32x16, i32div)
+
+DIV_SV(i64, i64x2, i64div)
+DIV_SV(i64, i64x3, i64div)
+DIV_SV(i64, i64x4, i64div)
+DIV_SV(i64, i64x8, i64div)
+DIV_SV(i64, i64x16, i64div)
+
+DIV_UV(u8, u8x2, u8div)
+DIV_UV(u8, u8x3, u8div)
+DIV_UV(u8, u8x4, u8div)
+DIV_UV(u8, u8x8, u8div)
+DIV_UV(u8, u8x16, u8div)
+
+DIV_UV(u16, u16x2, u16div)
+DIV_UV(u16, u16x3, u16div)
+DIV_UV(u16, u16x4, u16div)
+DIV_UV(u16, u16x8, u16div)
+DIV_UV(u16, u16x16, u16div)
+
+DIV_UV(u32, u32x2, u32div)
+DIV_UV(u32, u32x3, u32div)
+DIV_UV(u32, u32x4, u32div)
+DIV_UV(u32, u32x8, u32div)
+DIV_UV(u32, u32x16, u32div)
+
+DIV_UV(u64, u64x2, u64div)
+DIV_UV(u64, u64x3, u64div)
+DIV_UV(u64, u64x4, u64div)
+DIV_UV(u64, u64x8, u64div)
+DIV_UV(u64, u64x16, u64div)
+
+#undef DIV_AS
+#undef DIV_VMULHI32
+#undef DIV_X86_128
+#undef DIV_X86_256
+#undef DIV_X86_u32
+#undef DIV_X86_i32
+#undef DIV_MULHI32
+#undef DIV_MULHI64
+#undef DIV_U
+#undef DIV_S
+#undef DIV_UV
+#undef DIV_SV
+
+#endif /* SOL_DIV_H */
@@ -0,0 +1,186 @@
+/*
+** fma.h | The Sol Vector Library | Code for fused multiply-add.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_FMA_H
+#define SOL_FMA_H
+
+/*
+** Convenience Macros
+**
+** The floating `_fma` and `_fms` start with `FMA_##T(V, A, B, C, NEG)`, which
+** returns `FMA_V(a, b, c, neg)` early when FMA_ON says SOL_FMA wants one
+** rounding, or expands to nothing. `fms` is `fma` with `c` negated, which is
+** exact.
+**
+** GCC fuses `a * b + c` on its own wherever the target can (-ffp-contract=fast
+** is its default outside the strict ISO modes) and Clang does within one
+** expression, so SOL_FMA_SPLIT rounds the product first and passes it through
+** an empty asm with FMA_KEEP before adding. The asm emits nothing; it only
+** hides where the product came from. Scalars and vectors that fit an SSE/AVX
+** register stay in one, anything else (the wider vectors, and the structs of
+** SOL_N_GNU) takes a trip through memory. Compilers without GNU asm are left
+** to their own contraction setting.
+**
+** With SOL_GNU and x86 FMA, the 128- and 256-bit vectors are cast straight to
+** `__m128`/`__m256` and back, and an `f32x2` is widened to an `f32x4`, so
+** none of them leave their registers. The 512- and 1024-bit vectors are fused
+** 256 bits at a time through memory, since GCC cannot rebuild them from the
+** parts in registers; SOL_FMA_SPLIT keeps them in registers if that matters
+** more. Everywhere else each lane goes through fmaf/fma, which is one
+** instruction wherever SOL_FMA_HW holds and a correctly rounded libm call
+** elsewhere.
+*/
+
+#if SOL_FMA == SOL_FMA_EXACT || (SOL_FMA == SOL_FMA_FAST && SOL_FMA_HW)
+  #define FMA_ON 1
+#else
+  #define FMA_ON 0
+#endif
+
+#if defined(SOL_GNU) && defined(__FMA__)
+  #define FMA_X86 1
+#else
+  #define FMA_X86 0
+#endif
+
+#define FMA_CUT (SOL_FMA == SOL_FMA_SPLIT)
+
+#if defined(__AVX__)
+  #define FMA_XMM 32
+#elif defined(__SSE2__)
+  #define FMA_XMM 16
+#else
+  #define FMA_XMM 0
+#endif
+
+#if !defined(__GNUC__)
+  #define FMA_KEEP(X, REG)
+#elif defined(__i386__) || defined(__x86_64__)
+  #define FMA_KEEP(X, REG)             \
+    if ((REG) && sizeof(X) <= FMA_XMM) \
+      __asm__("" : "+x" (X));          \
+    else                               \
+      __asm__("" : "+m" (X));
+#else
+  #define FMA_KEEP(X, REG) __asm__("" : "+m" (X));
+#endif
+
+#ifdef SOL_GNU
+  #define FMA_VREG 1
+#else
+  #define FMA_VREG 0
+#endif
+
+#define FMA_V(V, A, B, C, NEG)                      \
+  if (FMA_ON)                                       \
+    return FMA_##V(A, B, C, NEG);                   \
+  if (FMA_CUT) {                                    \
+    V p_ = V##_mul(A, B);                           \
+    FMA_KEEP(p_, FMA_VREG)                          \
+    return (NEG) ? V##_sub(p_, C) : V##_add(p_, C); \
+  }
+
+#define FMA_f32(V, A, B, C, NEG) FMA_V(V, A, B, C, NEG)
+#define FMA_f64(V, A, B, C, NEG) FMA_V(V, A, B, C, NEG)
+
+_sol_
+f32 FMA_1_f32(f32 a, f32 b, f32 c) {
+  if (FMA_ON)
+    return fmaf(a, b, c);
+  f32 p = a * b;
+  if (FMA_CUT) {
+    FMA_KEEP(p, 1)
+  }
+  return p + c;
+}
+
+_sol_
+f64 FMA_1_f64(f64 a, f64 b, f64 c) {
+  if (FMA_ON)
+    return fma(a, b, c);
+  f64 p = a * b;
+  if (FMA_CUT) {
+    FMA_KEEP(p, 1)
+  }
+  return p + c;
+}
+
+/*
+** Definer Macros
+*/
+
+#define FMA_LANES(V, W, F) \
+_sol_ \
+V FMA_##V(V a, V b, V c, bool neg) {                                     \
+  V out = c;                                                             \
+  for (size_t i = 0; i < W; i++)                                         \
+    vec(out)[i] = F(vec(a)[i], vec(b)[i], neg ? -vec(c)[i] : vec(c)[i]); \
+  return out;                                                            \
+}
+
+#define FMA_REG(V, M, P, S) \
+_sol_ \
+V FMA_##V(V a, V b, V c, bool neg) {                                  \
+  const M x = (M) a, y = (M) b, z = (M) c;                            \
+  return (V) (neg ? P##_fmsub_##S(x, y, z) : P##_fmadd_##S(x, y, z)); \
+}
+
+#define FMA_MEM(V, T, M, S) \
+_sol_ \
+V FMA_##V(V a, V b, V c, bool neg) {                            \
+  V out;                                                        \
+  const T* x = (const T*) (const void*) &a;                     \
+  const T* y = (const T*) (const void*) &b;                     \
+  const T* z = (const T*) (const void*) &c;                     \
+  T* o = (T*) (void*) &out;                                     \
+  const size_t w = sizeof(M) / sizeof(T);                       \
+  for (size_t i = 0; i < sizeof(V) / sizeof(T); i += w) {       \
+    const M p = _mm256_loadu_##S(x + i);                        \
+    const M q = _mm256_loadu_##S(y + i);                        \
+    const M r = _mm256_loadu_##S(z + i);                        \
+    _mm256_storeu_##S(o + i, neg ? _mm256_fmsub_##S(p, q, r)    \
+                                 : _mm256_fmadd_##S(p, q, r));  \
+  }                                                             \
+  return out;                                                   \
+}
+
+/*
+** Fused Forms
+*/
+
+#if FMA_X86
+  FMA_REG(f32x3, __m128, _mm, ps)
+  FMA_REG(f32x4, __m128, _mm, ps)
+  FMA_REG(f32x8, __m256, _mm256, ps)
+  FMA_REG(f64x2, __m128d, _mm, pd)
+  FMA_REG(f64x3, __m256d, _mm256, pd)
+  FMA_REG(f64x4, __m256d, _mm256, pd)
+
+  _sol_
+  f32x2 FMA_f32x2(f32x2 a, f32x2 b, f32x2 c, bool neg) {
+    const f32x4 x = {a[0], a[1], a[0], a[1]};
+    const f32x4 y = {b[0], b[1], b[0], b[1]};
+    const f32x4 z = {c[0], c[1], c[0], c[1]};
+    const f32x4 o = FMA_f32x4(x, y, z, neg);
+    return (f32x2) {o[0], o[1]};
+  }
+
+  FMA_MEM(f32x16, f32, __m256, ps)
+  FMA_MEM(f64x8, f64, __m256d, pd)
+  FMA_MEM(f64x16, f64, __m256d, pd)
+#else
+  FMA_LANES(f32x2, 2, fmaf)
+  FMA_LANES(f32x3, 3, fmaf)
+  FMA_LANES(f32x4, 4, fmaf)
+  FMA_LANES(f32x8, 8, fmaf)
+  FMA_LANES(f32x16, 16, fmaf)
+  FMA_LANES(f64x2, 2, fma)
+  FMA_LANES(f64x3, 3, fma)
+  FMA_LANES(f64x4, 4, fma)
+  FMA_LANES(f64x8, 8, fma)
+  FMA_LANES(f64x16, 16, fma)
+#endif
+
+#endif /* SOL_FMA_H */
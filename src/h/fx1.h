@@ -22,6 +22,77 @@
   #pragma clang diagnostic ignored "-Wdouble-promotion"
 #endif
 
+/*
+** Convenience Macros
+**
+** FX1_TRIG_MAX is where the `_fast` and `_mid` range reduction stops working.
+** `k` times the leading part of 2pi or pi/2 is only exact while `k` fits in
+** the bits that part leaves free, so past this the reduced argument is noise
+** and those tiers hand off to `_precise`. Infinity and NaN go the same way.
+** The hand-off is kept out of line (FX1_COLD) so the common path stays small.
+**
+** FX1_RSQRT estimates 1 / sqrt(f) for an f32 to about 12 bits. With SSE that
+** is rsqrtss; otherwise it is the usual integer guess sharpened by two Newton
+** steps, which gets to about the same place.
+**
+** An f64 can be far outside the f32 range, so FX1_f64_rsqrt writes it as
+** `m * 4^k` with `m` in [1, 4), takes the f32 guess for `m` alone and scales
+** it by `2^-k`. Zero, subnormals, infinity and NaN have no such split, and
+** the guess has nothing to say about numbers below zero, so all of those go to
+** `1 / sqrt(f)`. FX1_f32_edge sends the same inputs that way for an f32.
+*/
+
+#define FX1_TRIG_MAX(T) ((sizeof(T) == 8) ? (T) 1e13 : (T) 1e4)
+
+#ifdef __GNUC__
+  #define FX1_COLD static __attribute__((noinline, unused))
+#else
+  #define FX1_COLD static inline
+#endif
+
+#if defined(SOL_GNU) && defined(__SSE__)
+  #define FX1_RSQRT(F) _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(F)))
+  #define FX1_SQRT(F) _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(F)))
+#else
+  #define FX1_RSQRT(F) FX1_f32_rsqrt(F)
+  #define FX1_SQRT(F) sqrtf(F)
+
+  _sol_
+  f32 FX1_f32_rsqrt(f32 f) {
+    u32 u;
+    memcpy(&u, &f, sizeof u);
+    u = 0x5f375a86 - (u >> 1);
+    f32 y;
+    memcpy(&y, &u, sizeof y);
+    y = y * (1.5f - 0.5f * f * y * y);
+    return y * (1.5f - 0.5f * f * y * y);
+  }
+#endif
+
+_sol_
+bool FX1_f32_edge(f32 f) {
+  u32 u;
+  memcpy(&u, &f, sizeof u);
+  return u - 0x00800000 >= 0x7f000000;
+}
+
+_sol_
+f64 FX1_f64_rsqrt(f64 f) {
+  u64 u;
+  memcpy(&u, &f, sizeof u);
+  if (u - 0x0010000000000000 >= 0x7fe0000000000000)
+    return 1 / sqrt(f);
+  const u64 e = u >> 52;
+  const u64 odd = (e & 1) ^ 1;
+  const u64 mu = (u & 0x000fffffffffffff) | ((1023 + odd) << 52);
+  const u64 su = ((3069 - e + odd) >> 1) << 52;
+  f64 m, scale;
+  memcpy(&m, &mu, sizeof m);
+  memcpy(&scale, &su, sizeof scale);
+  const f64 y = (f64) FX1_RSQRT((f32) m) * scale;
+  return y * (1.5 - 0.5 * f * y * y);
+}
+
 #define FX1(T, U) \
 \
 /* Math Functions */ \
@@ -37,6 +108,16 @@ T T##_sqrt(T f) {                               \
 }                                               \
 \
 _sol_ \
+T T##_rsqrt(T f) {                            \
+  if (sizeof(T) == 8)                         \
+    return (T) FX1_f64_rsqrt(f);              \
+  if (FX1_f32_edge((f32) f))                  \
+    return (T) (1 / FX1_SQRT((f32) f));       \
+  const T y = (T) FX1_RSQRT((f32) f);         \
+  return y * ((T) 1.5 - (T) 0.5 * f * y * y); \
+}                                             \
+\
+_sol_ \
 T T##_abs(T f) {                              \
   U* u = ((U*) &f);                           \
   *u &= (sizeof(T) == 8) ? 0x7fffffffffffffff \
@@ -53,9 +134,13 @@ T T##_abs_neg(T f) {                           \
 }                                              \
 \
 _sol_ \
+T T##_neg(T f) { \
+  return -f;     \
+}                \
+\
+_sol_ \
 T T##_neg_if(T f, u64 cond) {                         \
-  if (cond)                                           \
-    cond |= (sizeof(T) == 8) ? ~0ull : ~0u;           \
+  cond = (u64) 0 - (u64) (cond != 0);                 \
   U* u = ((U*) &f);                                   \
   *u ^= (sizeof(T) == 8) ? cond & ~0x7fffffffffffffff \
       : cond & ~0x7fffffff;                           \
@@ -63,67 +148,181 @@ T T##_neg_if(T f, u64 cond) {                         \
 }                                                     \
 \
 _sol_ \
-T T##_mod(T x, T y) { \
-  x = x / y;          \
-  if (sizeof(T) == 8) \
-    x -= (i64) x;     \
-  else                \
-    x -= (i32) x;     \
-  return x * y;       \
-}                     \
+T T##_floor(T f) {                                          \
+  if (!(T##_abs(f) < ((sizeof(T) == 8) ? 0x1p52 : 0x1p23))) \
+    return f;                                               \
+  const T t = (T) (i64) f;                                  \
+  return t - (T) (t > f);                                   \
+}                                                           \
+\
+_sol_ \
+T T##_mod(T x, T y) {              \
+  return x - y * T##_floor(x / y); \
+}                                  \
+\
+_sol_ \
+T T##_fma(T a, T b, T c) {   \
+  return FMA_1_##T(a, b, c); \
+}                            \
+\
+_sol_ \
+T T##_fms(T a, T b, T c) {    \
+  return FMA_1_##T(a, b, -c); \
+}                             \
 \
 /* Trig Functions */ \
 \
 _sol_ \
-T T##_sin(T f) {                \
-  return T##_cos(f - T##_pi_2); \
-}                               \
+T T##_sin(T f) {                           \
+  return (SOL_TRIG == SOL_TRIG_PRECISE)    \
+       ? T##_sin_precise(f)                \
+       : (SOL_TRIG == SOL_TRIG_MID)        \
+       ? T##_sin_mid(f) : T##_sin_fast(f); \
+}                                          \
 \
 _sol_ \
-T T##_cos_raw(T f) {                \
-  float f2 = f * f;                 \
-  float numer = T##_pi_sq - 4 * f2; \
-  return numer / (T##_pi_sq + f2);  \
-}                                   \
+T T##_cos(T f) {                           \
+  return (SOL_TRIG == SOL_TRIG_PRECISE)    \
+       ? T##_cos_precise(f)                \
+       : (SOL_TRIG == SOL_TRIG_MID)        \
+       ? T##_cos_mid(f) : T##_cos_fast(f); \
+}                                          \
 \
 _sol_ \
-T T##_cos(T f) {                              \
-  float fp2 = f + T##_pi_2;                   \
-  float s = -T##_mod(fp2, T##_pi) + T##_pi_2; \
-  float o = T##_cos_raw(s);                   \
-  u64 cond = T##_mod(fp2, T##_tau) > T##_pi;  \
-  o = T##_neg_if(o, cond);                    \
-  return o;                                   \
-}                                             \
+T T##_tan(T f) {                           \
+  return (SOL_TRIG == SOL_TRIG_PRECISE)    \
+       ? T##_tan_precise(f)                \
+       : (SOL_TRIG == SOL_TRIG_MID)        \
+       ? T##_tan_mid(f) : T##_tan_fast(f); \
+}                                          \
+\
+FX1_COLD \
+T FX1_##T##_sin_far(T f) { \
+  return T##_sin_precise(f); \
+}                            \
+\
+FX1_COLD \
+T FX1_##T##_cos_far(T f) { \
+  return T##_cos_precise(f); \
+}                            \
+\
+FX1_COLD \
+void FX1_##T##_sincos_far(T f, T* s, T* c) { \
+  T##_sincos_precise(f, s, c);                 \
+}                                              \
+\
+_sol_ \
+T T##_cos_raw(T f) {                  \
+  const T f2 = f * f;                 \
+  const T numer = T##_pi_sq - 4 * f2; \
+  return numer / (T##_pi_sq + f2);    \
+}                                     \
+\
+_sol_ \
+T FX1_##T##_cos_near(T f) {                                                  \
+  const T k = T##_floor(f * (T) 0.159154943091895335769 + (T) 0.5);          \
+  const T r = T##_abs(f - k * (T) 6.28125 - k * (T) 1.93530717958647692e-3); \
+  const T o = T##_cos_raw(T##_pi_2 - T##_abs(T##_pi_2 - r));                 \
+  return T##_neg_if(o, r > T##_pi_2);                                        \
+}                                                                            \
 \
 _sol_ \
-T T##_tan(T f) {                  \
-  return T##_sin(f) / T##_cos(f); \
-}                                 \
+T T##_sin_fast(T f) {                                               \
+  if (!(T##_abs(f) <= FX1_TRIG_MAX(T)))                             \
+    return FX1_##T##_sin_far(f);                                    \
+  const T k = T##_floor(f * (T) 0.159154943091895335769 + (T) 0.5); \
+  const T r = f - k * (T) 6.28125 - k * (T) 1.93530717958647692e-3; \
+  return FX1_##T##_cos_near(r - T##_pi_2);                          \
+}                                                                   \
 \
 _sol_ \
-T T##_asin(T f) {                                   \
-  return (T) (sizeof(T) == 8) ? asin(f) : asinf(f); \
-}                                                   \
+T T##_cos_fast(T f) {                     \
+  if (!(T##_abs(f) <= FX1_TRIG_MAX(T)))   \
+    return FX1_##T##_cos_far(f);          \
+  return FX1_##T##_cos_near(f);           \
+}                                         \
 \
 _sol_ \
-T T##_acos(T f) {                                   \
-  return (T) (sizeof(T) == 8) ? acos(f) : acosf(f); \
-}                                                   \
+T T##_tan_fast(T f) {                       \
+  return T##_sin_fast(f) / T##_cos_fast(f); \
+}                                           \
 \
 _sol_ \
-T T##_atan(T f) {                                   \
-  return (T) (sizeof(T) == 8) ? atan(f) : atanf(f); \
-}                                                   \
+void T##_sincos_mid(T f, T* s, T* c) {                                  \
+  if (!(T##_abs(f) <= FX1_TRIG_MAX(T))) {                               \
+    FX1_##T##_sincos_far(f, s, c);                                      \
+    return;                                                             \
+  }                                                                     \
+  const T k = T##_floor(f * (T) 0.63661977236758134308 + (T) 0.5);      \
+  const T r = f - k * (T) 1.5703125 - k * (T) 4.83826794896619231e-4;   \
+  const T r2 = r * r;                                                   \
+  T sp = r2 * (T) 8.33333333333333333e-3 - (T) 1.66666666666666667e-1;  \
+  T cp = r2 * (T) -1.38888888888888889e-3 + (T) 4.16666666666666667e-2; \
+  sp = r + r * r2 * sp;                                                 \
+  cp = 1 - (T) 0.5 * r2 + r2 * r2 * cp;                                 \
+  const U q = (U) (i64) (k - 4 * T##_floor(k * (T) 0.25));              \
+  const U swap = (U) 0 - (q & 1);                                       \
+  U* us = (U*) &sp;                                                     \
+  U* uc = (U*) &cp;                                                     \
+  const U ms = (*uc & swap) | (*us & ~swap);                            \
+  const U mc = (*us & swap) | (*uc & ~swap);                            \
+  *us = ms;                                                             \
+  *uc = mc;                                                             \
+  *s = T##_neg_if(sp, q & 2);                                           \
+  *c = T##_neg_if(cp, (q + 1) & 2);                                     \
+}                                                                       \
 \
 _sol_ \
-T T##_atan2(T y, T x) {                                     \
-  return (T) (sizeof(T) == 8) ? atan2(y, x) : atan2f(y, x); \
+T T##_sin_mid(T f) {         \
+  T s, c;                    \
+  T##_sincos_mid(f, &s, &c); \
+  return s;                  \
+}                            \
+\
+_sol_ \
+T T##_cos_mid(T f) {         \
+  T s, c;                    \
+  T##_sincos_mid(f, &s, &c); \
+  return c;                  \
+}                            \
+\
+_sol_ \
+T T##_tan_mid(T f) {         \
+  T s, c;                    \
+  T##_sincos_mid(f, &s, &c); \
+  return s / c;              \
+}                            \
+\
+_sol_ \
+T T##_sin_precise(T f) {         \
+  T s, c;                        \
+  T##_sincos_precise(f, &s, &c); \
+  return s;                      \
+}                                \
+\
+_sol_ \
+T T##_cos_precise(T f) {         \
+  T s, c;                        \
+  T##_sincos_precise(f, &s, &c); \
+  return c;                      \
+}                                \
+\
+_sol_ \
+T T##_tan_precise(T f) {         \
+  T s, c;                        \
+  T##_sincos_precise(f, &s, &c); \
+  return s / c;                  \
 }
 
 FX1(f32, u32)
 FX1(f64, u64)
 
+#undef FX1
+#undef FX1_RSQRT
+#undef FX1_SQRT
+#undef FX1_TRIG_MAX
+#undef FX1_COLD
+
 #ifdef __clang__
   #pragma clang diagnostic pop /* -Wdouble-promotion */
   #pragma clang diagnostic pop /* -Wfloat-conversion */
@@ -42,9 +42,9 @@ V V##_setf(T f) {       \
 }                       \
 \
 _sol_ \
-V V##_zero(void) {      \
-  return V##_setf(0);   \
-}                       \
+V V##_zero(void) {    \
+  return V##_setf(0); \
+}                     \
 \
 /* Vector Transformations */\
 \
@@ -65,10 +65,17 @@ V V##_scale(V v, T f) {            \
 \
 _sol_ \
 V V##_norm(V v) {                 \
+  if (SOL_NORM == SOL_NORM_FAST)  \
+    return V##_norm_fast(v);      \
   return V##_divf(v, V##_mag(v)); \
 }                                 \
 \
 _sol_ \
+V V##_norm_fast(V v) {                          \
+  return V##_mulf(v, T##_rsqrt(V##_dot(v, v))); \
+}                                               \
+\
+_sol_ \
 T V##_mag(V v) {                  \
   return T##_sqrt(V##_dot(v, v)); \
 }                                 \
@@ -77,7 +84,7 @@ _sol_ \
 V V##_proj(V a, V b) {                               \
   const T f = V##_mag(a) * T##_cos(V##_angle(a, b)); \
   return V##_mulf(b, f);                             \
-} \
+}                                                    \
 \
 _sol_ \
 V V##_rej(V a, V b) {                \
@@ -174,15 +181,44 @@ V V##_fdiv(T f, V v) {            \
 \
 _sol_ \
 V V##_fma(V a, V b, V c) {              \
+  FMA_##T(V, a, b, c, false)         \
   const V out = FX2_OP2(a, *, b, +, c); \
   return out;                           \
 }                                       \
 \
 _sol_ \
 V V##_fms(V a, V b, V c) {              \
+  FMA_##T(V, a, b, c, true)          \
   const V out = FX2_OP2(a, *, b, -, c); \
   return out;                           \
-}
+}                                       \
+\
+/* Bulk Kernels */ \
+\
+SOL_N2F(V##_rot, V, V, T, rad) \
+SOL_N2F(V##_scale, V, V, T, f) \
+SOL_N1(V##_norm, V, V) \
+SOL_N1(V##_norm_fast, V, V) \
+SOL_N1(V##_mag, T, V) \
+SOL_N2(V##_proj, V, V) \
+SOL_N2(V##_rej, V, V) \
+SOL_N2(V##_angle, T, V) \
+SOL_N2(V##_cross, T, V) \
+SOL_N2(V##_dot, T, V) \
+SOL_N1(V##_sum, T, V) \
+SOL_N1(V##_sq, V, V) \
+SOL_N2(V##_add, V, V) \
+SOL_N2F(V##_addf, V, V, T, f) \
+SOL_N2(V##_sub, V, V) \
+SOL_N2F(V##_subf, V, V, T, f) \
+SOL_NF2(V##_fsub, V, T, V) \
+SOL_N2(V##_mul, V, V) \
+SOL_N2F(V##_mulf, V, V, T, f) \
+SOL_N2(V##_div, V, V) \
+SOL_N2F(V##_divf, V, V, T, f) \
+SOL_NF2(V##_fdiv, V, T, V) \
+SOL_N3(V##_fma, V, V) \
+SOL_N3(V##_fms, V, V)
 
 FX2(f32, f32x2)
 FX2(f64, f64x2)
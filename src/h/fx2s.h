@@ -0,0 +1,191 @@
+/*
+** fx2s.h | The Sol Vector Library | Code for f32x2s and f64x2s.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_FX2S_H
+#define SOL_FX2S_H
+
+#define FX2S(T, V, L, S, B) \
+\
+/* Initializers */ \
+\
+_sol_ \
+S S##_set(T* x, T* y) { \
+  const S out = {x, y}; \
+  return out;           \
+}                       \
+\
+/* Element Access */ \
+\
+_sol_ \
+V S##_at(S s, size_t i) {         \
+  return V##_set(s.x[i], s.y[i]); \
+}                                 \
+\
+_sol_ \
+void S##_put(S s, size_t i, V v) { \
+  s.x[i] = x(v);                   \
+  s.y[i] = y(v);                   \
+}                                  \
+\
+/* Lane Access */ \
+\
+_sol_ \
+B B##_load(S s, size_t i) {          \
+  const B out = {L##_load(s.x + i),  \
+                 L##_load(s.y + i)}; \
+  return out;                        \
+}                                    \
+\
+_sol_ \
+B B##_loadn(S s, size_t i, size_t n) {   \
+  const B out = {L##_loadn(s.x + i, n),  \
+                 L##_loadn(s.y + i, n)}; \
+  return out;                            \
+}                                        \
+\
+_sol_ \
+void B##_store(S s, size_t i, B b) { \
+  L##_store(s.x + i, b.x);           \
+  L##_store(s.y + i, b.y);           \
+}                                    \
+\
+_sol_ \
+void B##_storen(S s, size_t i, B b, size_t n) { \
+  L##_storen(s.x + i, b.x, n);                  \
+  L##_storen(s.y + i, b.y, n);                  \
+}                                               \
+\
+/* Lane Math */ \
+\
+_sol_ \
+B B##_rot(B v, T cs, T sn) {         \
+  const L c = L##_setf(cs);          \
+  const L s = L##_setf(sn);          \
+  const B out = {v.x * c - v.y * s,  \
+                 v.x * s + v.y * c}; \
+  return out;                        \
+}                                    \
+\
+_sol_ \
+B B##_norm(B v) {                   \
+  if (SOL_NORM == SOL_NORM_FAST)    \
+    return B##_norm_fast(v);        \
+  const L m = B##_mag(v);           \
+  const B out = {v.x / m, v.y / m}; \
+  return out;                       \
+}                                   \
+\
+_sol_ \
+B B##_norm_fast(B v) {                  \
+  const L r = L##_rsqrt(B##_dot(v, v)); \
+  const B out = {v.x * r, v.y * r};     \
+  return out;                           \
+}                                       \
+\
+_sol_ \
+L B##_mag(B v) {                  \
+  return L##_sqrt(B##_dot(v, v)); \
+}                                 \
+\
+_sol_ \
+B B##_proj(B a, B b) {                    \
+  const L f = B##_dot(a, b) / B##_mag(b); \
+  const B out = {b.x * f, b.y * f};       \
+  return out;                             \
+}                                         \
+\
+_sol_ \
+L B##_cross(B a, B b) {         \
+  return a.x * b.y - b.x * a.y; \
+}                               \
+\
+_sol_ \
+L B##_dot(B a, B b) {           \
+  return a.x * b.x + a.y * b.y; \
+}                               \
+\
+_sol_ \
+L B##_angle(B a, B b) {                             \
+  return L##_atan2(B##_cross(a, b), B##_dot(a, b)); \
+}                                                   \
+\
+/* Stream Math */ \
+\
+SOL_KERNEL(S##_rot, (S dst, S v, T rad, size_t n), (dst, v, rad, n), { \
+  const T cs = T##_cos(rad);                                            \
+  const T sn = T##_sin(rad);                                            \
+  size_t i = 0;                                                         \
+  for (; i + L##_w <= n; i += L##_w)                                    \
+    B##_store(dst, i, B##_rot(B##_load(v, i), cs, sn));                 \
+  if (i < n)                                                            \
+    B##_storen(dst, i, B##_rot(B##_loadn(v, i, n - i), cs, sn), n - i); \
+})                                                                      \
+\
+SOL_KERNEL(S##_norm, (S dst, S v, size_t n), (dst, v, n), { \
+  size_t i = 0;                                                  \
+  for (; i + L##_w <= n; i += L##_w)                             \
+    B##_store(dst, i, B##_norm(B##_load(v, i)));                 \
+  if (i < n)                                                     \
+    B##_storen(dst, i, B##_norm(B##_loadn(v, i, n - i)), n - i); \
+})                                                               \
+\
+SOL_KERNEL(S##_norm_fast, (S dst, S v, size_t n), (dst, v, n), { \
+  size_t i = 0;                                                       \
+  for (; i + L##_w <= n; i += L##_w)                                  \
+    B##_store(dst, i, B##_norm_fast(B##_load(v, i)));                 \
+  if (i < n)                                                          \
+    B##_storen(dst, i, B##_norm_fast(B##_loadn(v, i, n - i)), n - i); \
+})                                                                    \
+\
+SOL_KERNEL(S##_mag, (T* dst, S v, size_t n), (dst, v, n), { \
+  size_t i = 0;                                                  \
+  for (; i + L##_w <= n; i += L##_w)                             \
+    L##_store(dst + i, B##_mag(B##_load(v, i)));                 \
+  if (i < n)                                                     \
+    L##_storen(dst + i, B##_mag(B##_loadn(v, i, n - i)), n - i); \
+})                                                               \
+\
+SOL_KERNEL(S##_proj, (S dst, S a, S b, size_t n), (dst, a, b, n), { \
+  size_t i = 0;                                                  \
+  for (; i + L##_w <= n; i += L##_w)                             \
+    B##_store(dst, i, B##_proj(B##_load(a, i), B##_load(b, i))); \
+  if (i < n)                                                     \
+    B##_storen(dst, i, B##_proj(B##_loadn(a, i, n - i),          \
+                                B##_loadn(b, i, n - i)), n - i); \
+})                                                               \
+\
+SOL_KERNEL(S##_cross, (T* dst, S a, S b, size_t n), (dst, a, b, n), { \
+  size_t i = 0;                                                    \
+  for (; i + L##_w <= n; i += L##_w)                               \
+    L##_store(dst + i, B##_cross(B##_load(a, i), B##_load(b, i))); \
+  if (i < n)                                                       \
+    L##_storen(dst + i, B##_cross(B##_loadn(a, i, n - i),          \
+                                  B##_loadn(b, i, n - i)), n - i); \
+})                                                                 \
+\
+SOL_KERNEL(S##_angle, (T* dst, S a, S b, size_t n), (dst, a, b, n), { \
+  size_t i = 0;                                                    \
+  for (; i + L##_w <= n; i += L##_w)                               \
+    L##_store(dst + i, B##_angle(B##_load(a, i), B##_load(b, i))); \
+  if (i < n)                                                       \
+    L##_storen(dst + i, B##_angle(B##_loadn(a, i, n - i),          \
+                                  B##_loadn(b, i, n - i)), n - i); \
+})                                                                 \
+\
+SOL_KERNEL(S##_dot, (T* dst, S a, S b, size_t n), (dst, a, b, n), { \
+  size_t i = 0;                                                  \
+  for (; i + L##_w <= n; i += L##_w)                             \
+    L##_store(dst + i, B##_dot(B##_load(a, i), B##_load(b, i))); \
+  if (i < n)                                                     \
+    L##_storen(dst + i, B##_dot(B##_loadn(a, i, n - i),          \
+                                B##_loadn(b, i, n - i)), n - i); \
+})
+
+FX2S(f32, f32x2, f32l, f32x2s, f32x2l)
+FX2S(f64, f64x2, f64l, f64x2s, f64x2l)
+
+#undef FX2S
+
+#endif /* SOL_FX2S_H */
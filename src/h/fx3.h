@@ -53,10 +53,17 @@ V V##_scale(V v, T f) { \
 /* Vector Math */ \
 _sol_ \
 V V##_norm(V v) { \
+  if (SOL_NORM == SOL_NORM_FAST) \
+    return V##_norm_fast(v); \
   return V##_divf(v, V##_mag(v)); \
 } \
 \
 _sol_ \
+V V##_norm_fast(V v) { \
+  return V##_mulf(v, T##_rsqrt(V##_dot(v, v))); \
+} \
+\
+_sol_ \
 T V##_mag(V v) { \
  return T##_sqrt(V##_dot(v, v)); \
 } \
@@ -73,7 +80,7 @@ V V##_rej(V a, V b) { \
 \
 _sol_ \
 T V##_angle(V a, V b) {                                       \
-  return T##_acos(V##_dot(a, b) / (V##_mag(a) / V##_mag(b))); \
+  return T##_atan2(V##_mag(V##_cross(a, b)), V##_dot(a, b));  \
 }                                                             \
 \
 _sol_ \
@@ -163,41 +170,48 @@ V V##_fdiv(T f, V v) {            \
 \
 _sol_ \
 V V##_fma(V a, V b, V c) {              \
+  FMA_##T(V, a, b, c, false)         \
   const V out = FX3_OP2(a, *, b, +, c); \
   return out;                           \
 }                                       \
 \
 _sol_ \
 V V##_fms(V a, V b, V c) {              \
+  FMA_##T(V, a, b, c, true)          \
   const V out = FX3_OP2(a, *, b, -, c); \
   return out;                           \
 }                                       \
+\
+/* Bulk Kernels */ \
+\
+SOL_N2F(V##_rot, V, V, Q, q) \
+SOL_N2F(V##_scale, V, V, T, f) \
+SOL_N1(V##_norm, V, V) \
+SOL_N1(V##_norm_fast, V, V) \
+SOL_N1(V##_mag, T, V) \
+SOL_N2(V##_proj, V, V) \
+SOL_N2(V##_rej, V, V) \
+SOL_N2(V##_angle, T, V) \
+SOL_N2(V##_cross, V, V) \
+SOL_N2(V##_dot, T, V) \
+SOL_N1(V##_sum, T, V) \
+SOL_N1(V##_sq, V, V) \
+SOL_N2(V##_add, V, V) \
+SOL_N2F(V##_addf, V, V, T, f) \
+SOL_N2(V##_sub, V, V) \
+SOL_N2F(V##_subf, V, V, T, f) \
+SOL_NF2(V##_fsub, V, T, V) \
+SOL_N2(V##_mul, V, V) \
+SOL_N2F(V##_mulf, V, V, T, f) \
+SOL_N2(V##_div, V, V) \
+SOL_N2F(V##_divf, V, V, T, f) \
+SOL_NF2(V##_fdiv, V, T, V) \
+SOL_N3(V##_fma, V, V) \
+SOL_N3(V##_fms, V, V)
 
 FX3(f32, f32x3, u32x3, f32x4)
 FX3(f64, f64x3, u64x3, f64x4)
 
-_sol_
-f32x3 f32x3_yzx(f32x3 v) {
-  #if __has_builtin(__builtin_shufflevector)
-    return __builtin_shufflevector(v, v, 1, 2, 0, 0);
-  #elif __has_builtin(__builtin_shuffle)
-    return __builtin_shuffle(v, (u32x4) {1, 2, 0, 0});
-  #else
-    return (f32x3) {y(v), z(v), x(v), x(v)};
-  #endif
-}
-
-_sol_
-f64x3 f64x3_yzx(f64x3 v) {
-  #if __has_builtin(__builtin_shufflevector)
-    return __builtin_shufflevector(v, v, 1, 2, 0, 0);
-  #elif __has_builtin(__builtin_shuffle)
-    return __builtin_shuffle(v, (u64x4) {1, 2, 0, 0});
-  #else
-    return (f64x3) {y(v), z(v), x(v), x(v)};
-  #endif
-}
-
 #undef FX3
 #undef FX3_OPF
 #undef FX3_FOP
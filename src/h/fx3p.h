@@ -0,0 +1,108 @@
+/*
+** fx3p.h | The Sol Vector Library | Code for f32x3p and f64x3p.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_FX3P_H
+#define SOL_FX3P_H
+
+/*
+** Convenience Macros
+**
+** With GNU vectors, four packed elements are exactly three full vectors of
+** memory, so the bulk kernels move them with three unaligned loads or stores
+** and regroup the lanes with shuffles. FX3P_UNPACK zeroes the padding lane,
+** the same as `Tx3_set`. FX3P_GNU keeps its argument only under SOL_GNU.
+*/
+
+#ifdef SOL_GNU
+  #define FX3P_GNU(...) __VA_ARGS__
+
+  #if __has_builtin(__builtin_shufflevector)
+    #define FX3P_SHUF(K, A, B, I, J, L, N) \
+      __builtin_shufflevector(A, B, I, J, L, N)
+  #else
+    #define FX3P_SHUF(K, A, B, I, J, L, N) \
+      __builtin_shuffle(A, B, (K) {I, J, L, N})
+  #endif
+
+  #define FX3P_UNPACK(V, K, M, O)                      \
+    const V zero = {0};                                \
+    const V t1 = FX3P_SHUF(K, M[0], M[1], 3, 4, 5, 5); \
+    const V t2 = FX3P_SHUF(K, M[1], M[2], 2, 3, 4, 4); \
+    O[0] = FX3P_SHUF(K, M[0], zero, 0, 1, 2, 4);       \
+    O[1] = FX3P_SHUF(K, t1, zero, 0, 1, 2, 4);         \
+    O[2] = FX3P_SHUF(K, t2, zero, 0, 1, 2, 4);         \
+    O[3] = FX3P_SHUF(K, M[2], zero, 1, 2, 3, 4)
+
+  #define FX3P_PACK(K, V, M)                     \
+    M[0] = FX3P_SHUF(K, V[0], V[1], 0, 1, 2, 4); \
+    M[1] = FX3P_SHUF(K, V[1], V[2], 1, 2, 4, 5); \
+    M[2] = FX3P_SHUF(K, V[2], V[3], 2, 4, 5, 6)
+#else
+  #define FX3P_GNU(...)
+#endif
+
+/*
+** Definer Macros
+*/
+
+#define FX3P(T, V, P, K) \
+\
+/* Conversion */ \
+\
+_sol_ \
+P V##_pack(V v) {                   \
+  const P out = {x(v), y(v), z(v)}; \
+  return out;                       \
+}                                   \
+\
+_sol_ \
+V V##_unpack(P p) {              \
+  return V##_set(p.x, p.y, p.z); \
+}                                \
+\
+/* Bulk Conversion */ \
+\
+SOL_KERNEL(V##_pack_n, (P* dst, const V* v, size_t n), (dst, v, n), { \
+  size_t i = 0;                      \
+  FX3P_GNU(                          \
+    for (; i + 4 <= n; i += 4) {     \
+      V m[3];                        \
+      FX3P_PACK(K, (v + i), m);      \
+      memcpy(dst + i, m, sizeof(m)); \
+    }                                \
+  )                                  \
+  for (; i < n; i++)                 \
+    dst[i] = V##_pack(v[i]);         \
+})                                   \
+SOL_PAR_N1(V##_pack, P, V)           \
+\
+SOL_KERNEL(V##_unpack_n, (V* dst, const P* p, size_t n), (dst, p, n), { \
+  size_t i = 0;                    \
+  FX3P_GNU(                        \
+    for (; i + 4 <= n; i += 4) {   \
+      V m[3], o[4];                \
+      memcpy(m, p + i, sizeof(m)); \
+      FX3P_UNPACK(V, K, m, o);     \
+      dst[i + 0] = o[0];           \
+      dst[i + 1] = o[1];           \
+      dst[i + 2] = o[2];           \
+      dst[i + 3] = o[3];           \
+    }                              \
+  )                                \
+  for (; i < n; i++)               \
+    dst[i] = V##_unpack(p[i]);     \
+})                                 \
+SOL_PAR_N1(V##_unpack, V, P)
+
+FX3P(f32, f32x3, f32x3p, u32x4)
+FX3P(f64, f64x3, f64x3p, u64x4)
+
+#undef FX3P
+#undef FX3P_GNU
+#undef FX3P_SHUF
+#undef FX3P_UNPACK
+#undef FX3P_PACK
+
+#endif /* SOL_FX3P_H */
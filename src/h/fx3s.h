@@ -0,0 +1,201 @@
+/*
+** fx3s.h | The Sol Vector Library | Code for f32x3s and f64x3s.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_FX3S_H
+#define SOL_FX3S_H
+
+#define FX3S(T, V, L, S, B, Q) \
+\
+/* Initializers */ \
+\
+_sol_ \
+S S##_set(T* x, T* y, T* z) { \
+  const S out = {x, y, z};    \
+  return out;                 \
+}                             \
+\
+/* Element Access */ \
+\
+_sol_ \
+V S##_at(S s, size_t i) {                 \
+  return V##_set(s.x[i], s.y[i], s.z[i]); \
+}                                         \
+\
+_sol_ \
+void S##_put(S s, size_t i, V v) { \
+  s.x[i] = x(v);                   \
+  s.y[i] = y(v);                   \
+  s.z[i] = z(v);                   \
+}                                  \
+\
+/* Lane Access */ \
+\
+_sol_ \
+B B##_load(S s, size_t i) {          \
+  const B out = {L##_load(s.x + i),  \
+                 L##_load(s.y + i),  \
+                 L##_load(s.z + i)}; \
+  return out;                        \
+}                                    \
+\
+_sol_ \
+B B##_loadn(S s, size_t i, size_t n) {   \
+  const B out = {L##_loadn(s.x + i, n),  \
+                 L##_loadn(s.y + i, n),  \
+                 L##_loadn(s.z + i, n)}; \
+  return out;                            \
+}                                        \
+\
+_sol_ \
+void B##_store(S s, size_t i, B b) { \
+  L##_store(s.x + i, b.x);           \
+  L##_store(s.y + i, b.y);           \
+  L##_store(s.z + i, b.z);           \
+}                                    \
+\
+_sol_ \
+void B##_storen(S s, size_t i, B b, size_t n) { \
+  L##_storen(s.x + i, b.x, n);                  \
+  L##_storen(s.y + i, b.y, n);                  \
+  L##_storen(s.z + i, b.z, n);                  \
+}                                               \
+\
+/* Lane Math */ \
+\
+_sol_ \
+B B##_rot(B v, Q q) {                                            \
+  const B qv = {L##_setf(x(q)), L##_setf(y(q)), L##_setf(z(q))}; \
+  const L qw = L##_setf(w(q));                                   \
+  const B c = B##_cross(qv, v);                                  \
+  const B t = {c.x + c.x, c.y + c.y, c.z + c.z};                 \
+  const B u = B##_cross(qv, t);                                  \
+  const B out = {v.x + t.x * qw + u.x,                           \
+                 v.y + t.y * qw + u.y,                           \
+                 v.z + t.z * qw + u.z};                          \
+  return out;                                                    \
+}                                                                \
+\
+_sol_ \
+B B##_norm(B v) {                            \
+  if (SOL_NORM == SOL_NORM_FAST)             \
+    return B##_norm_fast(v);                 \
+  const L m = B##_mag(v);                    \
+  const B out = {v.x / m, v.y / m, v.z / m}; \
+  return out;                                \
+}                                            \
+\
+_sol_ \
+B B##_norm_fast(B v) {                       \
+  const L r = L##_rsqrt(B##_dot(v, v));      \
+  const B out = {v.x * r, v.y * r, v.z * r}; \
+  return out;                                \
+}                                            \
+\
+_sol_ \
+L B##_mag(B v) {                  \
+  return L##_sqrt(B##_dot(v, v)); \
+}                                 \
+\
+_sol_ \
+B B##_proj(B a, B b) {                       \
+  const L f = B##_dot(a, b) / B##_dot(a, a); \
+  const B out = {a.x * f, a.y * f, a.z * f}; \
+  return out;                                \
+}                                            \
+\
+_sol_ \
+B B##_cross(B a, B b) {                  \
+  const B out = {a.y * b.z - a.z * b.y,  \
+                 a.z * b.x - a.x * b.z,  \
+                 a.x * b.y - a.y * b.x}; \
+  return out;                            \
+}                                        \
+\
+_sol_ \
+L B##_dot(B a, B b) {                       \
+  return a.x * b.x + a.y * b.y + a.z * b.z; \
+}                                           \
+\
+_sol_ \
+L B##_angle(B a, B b) {                                      \
+  return L##_atan2(B##_mag(B##_cross(a, b)), B##_dot(a, b)); \
+}                                                            \
+\
+/* Stream Math */ \
+\
+SOL_KERNEL(S##_rot, (S dst, S v, Q q, size_t n), (dst, v, q, n), { \
+  size_t i = 0;                                                    \
+  for (; i + L##_w <= n; i += L##_w)                               \
+    B##_store(dst, i, B##_rot(B##_load(v, i), q));                 \
+  if (i < n)                                                       \
+    B##_storen(dst, i, B##_rot(B##_loadn(v, i, n - i), q), n - i); \
+})                                                                 \
+\
+SOL_KERNEL(S##_norm, (S dst, S v, size_t n), (dst, v, n), { \
+  size_t i = 0;                                                  \
+  for (; i + L##_w <= n; i += L##_w)                             \
+    B##_store(dst, i, B##_norm(B##_load(v, i)));                 \
+  if (i < n)                                                     \
+    B##_storen(dst, i, B##_norm(B##_loadn(v, i, n - i)), n - i); \
+})                                                               \
+\
+SOL_KERNEL(S##_norm_fast, (S dst, S v, size_t n), (dst, v, n), { \
+  size_t i = 0;                                                       \
+  for (; i + L##_w <= n; i += L##_w)                                  \
+    B##_store(dst, i, B##_norm_fast(B##_load(v, i)));                 \
+  if (i < n)                                                          \
+    B##_storen(dst, i, B##_norm_fast(B##_loadn(v, i, n - i)), n - i); \
+})                                                                    \
+\
+SOL_KERNEL(S##_mag, (T* dst, S v, size_t n), (dst, v, n), { \
+  size_t i = 0;                                                  \
+  for (; i + L##_w <= n; i += L##_w)                             \
+    L##_store(dst + i, B##_mag(B##_load(v, i)));                 \
+  if (i < n)                                                     \
+    L##_storen(dst + i, B##_mag(B##_loadn(v, i, n - i)), n - i); \
+})                                                               \
+\
+SOL_KERNEL(S##_proj, (S dst, S a, S b, size_t n), (dst, a, b, n), { \
+  size_t i = 0;                                                  \
+  for (; i + L##_w <= n; i += L##_w)                             \
+    B##_store(dst, i, B##_proj(B##_load(a, i), B##_load(b, i))); \
+  if (i < n)                                                     \
+    B##_storen(dst, i, B##_proj(B##_loadn(a, i, n - i),          \
+                                B##_loadn(b, i, n - i)), n - i); \
+})                                                               \
+\
+SOL_KERNEL(S##_cross, (S dst, S a, S b, size_t n), (dst, a, b, n), { \
+  size_t i = 0;                                                   \
+  for (; i + L##_w <= n; i += L##_w)                              \
+    B##_store(dst, i, B##_cross(B##_load(a, i), B##_load(b, i))); \
+  if (i < n)                                                      \
+    B##_storen(dst, i, B##_cross(B##_loadn(a, i, n - i),          \
+                                 B##_loadn(b, i, n - i)), n - i); \
+})                                                                \
+\
+SOL_KERNEL(S##_angle, (T* dst, S a, S b, size_t n), (dst, a, b, n), { \
+  size_t i = 0;                                                    \
+  for (; i + L##_w <= n; i += L##_w)                               \
+    L##_store(dst + i, B##_angle(B##_load(a, i), B##_load(b, i))); \
+  if (i < n)                                                       \
+    L##_storen(dst + i, B##_angle(B##_loadn(a, i, n - i),          \
+                                  B##_loadn(b, i, n - i)), n - i); \
+})                                                                 \
+\
+SOL_KERNEL(S##_dot, (T* dst, S a, S b, size_t n), (dst, a, b, n), { \
+  size_t i = 0;                                                  \
+  for (; i + L##_w <= n; i += L##_w)                             \
+    L##_store(dst + i, B##_dot(B##_load(a, i), B##_load(b, i))); \
+  if (i < n)                                                     \
+    L##_storen(dst + i, B##_dot(B##_loadn(a, i, n - i),          \
+                                B##_loadn(b, i, n - i)), n - i); \
+})
+
+FX3S(f32, f32x3, f32l, f32x3s, f32x3l, f32x4)
+FX3S(f64, f64x3, f64l, f64x3s, f64x3l, f64x4)
+
+#undef FX3S
+
+#endif /* SOL_FX3S_H */
@@ -0,0 +1,107 @@
+/*
+** fx3x3.h | The Sol Vector Library | Code for f32x3x3 and f64x3x3.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_FX3X3_H
+#define SOL_FX3X3_H
+
+/*
+** Convenience Macros
+**
+** FX3X3_TRANS transposes the columns `A`, `B`, `C` into `O`. With GNU vectors
+** the padding lane of each column is left holding a copy of another lane, the
+** same as `Tx3_yzx` does.
+*/
+
+#if !defined(SOL_GNU)
+  #define FX3X3_TRANS(V, K, A, B, C, O) \
+    O.c[0] = V##_set(x(A), x(B), x(C)); \
+    O.c[1] = V##_set(y(A), y(B), y(C)); \
+    O.c[2] = V##_set(z(A), z(B), z(C))
+#else
+  #if __has_builtin(__builtin_shufflevector)
+    #define FX3X3_SHUF(K, A, B, I, J, L, N) \
+      __builtin_shufflevector(A, B, I, J, L, N)
+  #else
+    #define FX3X3_SHUF(K, A, B, I, J, L, N) \
+      __builtin_shuffle(A, B, (K) {I, J, L, N})
+  #endif
+
+  #define FX3X3_TRANS(V, K, A, B, C, O)           \
+    const V t0 = FX3X3_SHUF(K, A, B, 0, 4, 1, 5); \
+    const V t1 = FX3X3_SHUF(K, A, B, 2, 6, 2, 6); \
+    O.c[0] = FX3X3_SHUF(K, t0, C, 0, 1, 4, 4);    \
+    O.c[1] = FX3X3_SHUF(K, t0, C, 2, 3, 5, 5);    \
+    O.c[2] = FX3X3_SHUF(K, t1, C, 0, 1, 6, 6)
+#endif
+
+/*
+** Definer Macros
+**
+** `M` is column-major, like the 4x4 types. The inverse is the transposed
+** matrix of column cross products over the determinant.
+*/
+
+#define FX3X3(T, V, M, K) \
+\
+/* Initializers */ \
+\
+_sol_ \
+M M##_set(V c0, V c1, V c2) {   \
+  const M out = {{c0, c1, c2}}; \
+  return out;                   \
+}                               \
+\
+_sol_ \
+M M##_id(void) {                                     \
+  return M##_set(V##_set(1, 0, 0), V##_set(0, 1, 0), \
+                 V##_set(0, 0, 1));                  \
+}                                                    \
+\
+/* Matrix Math */ \
+\
+_sol_ \
+V M##_mulv(M m, V v) {                            \
+  const V o = V##_mulf(m.c[0], x(v));             \
+  const V p = V##_fma(m.c[1], V##_setf(y(v)), o); \
+  return V##_fma(m.c[2], V##_setf(z(v)), p);      \
+}                                                 \
+\
+_sol_ \
+M M##_mul(M a, M b) {                  \
+  return M##_set(M##_mulv(a, b.c[0]),  \
+                 M##_mulv(a, b.c[1]),  \
+                 M##_mulv(a, b.c[2])); \
+}                                      \
+\
+_sol_ \
+M M##_trans(M m) {                                \
+  M out;                                          \
+  FX3X3_TRANS(V, K, m.c[0], m.c[1], m.c[2], out); \
+  return out;                                     \
+}                                                 \
+\
+_sol_ \
+T M##_det(M m) {                                     \
+  return V##_dot(m.c[0], V##_cross(m.c[1], m.c[2])); \
+}                                                    \
+\
+_sol_ \
+M M##_inv(M m) {                                \
+  const V bc = V##_cross(m.c[1], m.c[2]);       \
+  const T inv = (T) 1 / V##_dot(m.c[0], bc);    \
+  return M##_trans(M##_set(                     \
+    V##_mulf(bc, inv),                          \
+    V##_mulf(V##_cross(m.c[2], m.c[0]), inv),   \
+    V##_mulf(V##_cross(m.c[0], m.c[1]), inv))); \
+}
+
+FX3X3(f32, f32x3, f32x3x3, u32x4)
+FX3X3(f64, f64x3, f64x3x3, u64x4)
+
+#undef FX3X3
+#undef FX3X3_TRANS
+#undef FX3X3_SHUF
+
+#endif /* SOL_FX3X3_H */
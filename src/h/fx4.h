@@ -26,7 +26,7 @@ _sol_ \
 V V##_set(T x, T y, T z, T w) { \
   const V out = {x, y, z, w};   \
   return out;                   \
-} \
+}                               \
 \
 _sol_ \
 V V##_setf(T f) {             \
@@ -38,6 +38,32 @@ V V##_zero(void) {        \
   return V##_setf((T) 0); \
 }                         \
 \
+/* Vector Transformations */ \
+\
+_sol_ \
+V V##_scale(V v, T f) {            \
+  return V##_mulf(V##_norm(v), f); \
+}                                  \
+\
+/* Vector Math */ \
+\
+_sol_ \
+V V##_norm(V v) {                 \
+  if (SOL_NORM == SOL_NORM_FAST)  \
+    return V##_norm_fast(v);      \
+  return V##_divf(v, V##_mag(v)); \
+}                                 \
+\
+_sol_ \
+V V##_norm_fast(V v) {                               \
+  return V##_mulf(v, T##_rsqrt(V##_sum(V##_sq(v)))); \
+}                                                    \
+\
+_sol_ \
+T V##_mag(V v) {                       \
+  return T##_sqrt(V##_sum(V##_sq(v))); \
+}                                      \
+\
 /* Basic Math */ \
 \
 _sol_ \
@@ -46,6 +72,11 @@ T V##_sum(V v) {                    \
 }                                   \
 \
 _sol_ \
+V V##_sq(V v) {         \
+  return V##_mul(v, v); \
+}                       \
+\
+_sol_ \
 V V##_add(V a, V b) {            \
   const V out = FX4_OP(a, +, b); \
   return out;                    \
@@ -70,6 +101,12 @@ V V##_subf(V v, T f) {            \
 }                                 \
 \
 _sol_ \
+V V##_fsub(T f, V v) {            \
+  const V out = FX4_FOP(f, -, v); \
+  return out;                     \
+}                                 \
+\
+_sol_ \
 V V##_mul(V a, V b) {            \
   const V out = FX4_OP(a, *, b); \
   return out;                    \
@@ -101,15 +138,38 @@ V V##_fdiv(T f, V v) {            \
 \
 _sol_ \
 V V##_fma(V a, V b, V c) {              \
+  FMA_##T(V, a, b, c, false)         \
   const V out = FX4_OP2(a, *, b, +, c); \
   return out;                           \
 }                                       \
 \
 _sol_ \
 V V##_fms(V a, V b, V c) {              \
+  FMA_##T(V, a, b, c, true)          \
   const V out = FX4_OP2(a, *, b, -, c); \
   return out;                           \
 }                                       \
+\
+/* Bulk Kernels */ \
+\
+SOL_N2F(V##_scale, V, V, T, f) \
+SOL_N1(V##_norm, V, V) \
+SOL_N1(V##_norm_fast, V, V) \
+SOL_N1(V##_mag, T, V) \
+SOL_N1(V##_sum, T, V) \
+SOL_N1(V##_sq, V, V) \
+SOL_N2(V##_add, V, V) \
+SOL_N2F(V##_addf, V, V, T, f) \
+SOL_N2(V##_sub, V, V) \
+SOL_N2F(V##_subf, V, V, T, f) \
+SOL_NF2(V##_fsub, V, T, V) \
+SOL_N2(V##_mul, V, V) \
+SOL_N2F(V##_mulf, V, V, T, f) \
+SOL_N2(V##_div, V, V) \
+SOL_N2F(V##_divf, V, V, T, f) \
+SOL_NF2(V##_fdiv, V, T, V) \
+SOL_N3(V##_fma, V, V) \
+SOL_N3(V##_fms, V, V)
 
 FX4(f32, f32x4)
 FX4(f64, f64x4)
@@ -0,0 +1,262 @@
+/*
+** fx4x4.h | The Sol Vector Library | Code for f32x4x4 and f64x4x4.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_FX4X4_H
+#define SOL_FX4X4_H
+
+/*
+** Convenience Macros
+**
+** FX4X4_TRANS transposes the columns `A`, `B`, `C`, `D` into `O`. With GNU
+** vectors it interleaves pairs of columns and then pairs of halves, which is
+** eight shuffles and no trips through memory.
+*/
+
+#if !defined(SOL_GNU)
+  #define FX4X4_TRANS(V, K, A, B, C, D, O)    \
+    O.c[0] = V##_set(x(A), x(B), x(C), x(D)); \
+    O.c[1] = V##_set(y(A), y(B), y(C), y(D)); \
+    O.c[2] = V##_set(z(A), z(B), z(C), z(D)); \
+    O.c[3] = V##_set(w(A), w(B), w(C), w(D))
+#else
+  #if __has_builtin(__builtin_shufflevector)
+    #define FX4X4_SHUF(K, A, B, I, J, L, N) \
+      __builtin_shufflevector(A, B, I, J, L, N)
+  #else
+    #define FX4X4_SHUF(K, A, B, I, J, L, N) \
+      __builtin_shuffle(A, B, (K) {I, J, L, N})
+  #endif
+
+  #define FX4X4_TRANS(V, K, A, B, C, D, O)        \
+    const V t0 = FX4X4_SHUF(K, A, B, 0, 4, 1, 5); \
+    const V t1 = FX4X4_SHUF(K, A, B, 2, 6, 3, 7); \
+    const V t2 = FX4X4_SHUF(K, C, D, 0, 4, 1, 5); \
+    const V t3 = FX4X4_SHUF(K, C, D, 2, 6, 3, 7); \
+    O.c[0] = FX4X4_SHUF(K, t0, t2, 0, 1, 4, 5);   \
+    O.c[1] = FX4X4_SHUF(K, t0, t2, 2, 3, 6, 7);   \
+    O.c[2] = FX4X4_SHUF(K, t1, t3, 0, 1, 4, 5);   \
+    O.c[3] = FX4X4_SHUF(K, t1, t3, 2, 3, 6, 7)
+#endif
+
+/*
+** FX4X4_XYZ drops the last lane of `R` to make a `V3`; with GNU vectors the
+** types are the same width, so this is free and the padding lane is junk.
+**
+** FX4X4_STREAM_V stores `R` to `P` around the cache, and FX4X4_FENCE orders
+** those stores before anything after the kernel. Without SSE, or with the
+** unaligned struct types, these fall back to a plain store and nothing.
+*/
+
+#ifdef SOL_GNU
+  #define FX4X4_XYZ(V3, R) ((V3) (R))
+#else
+  #define FX4X4_XYZ(V3, R) V3##_set(x(R), y(R), z(R))
+#endif
+
+#if defined(SOL_GNU) && defined(__SSE__)
+  #define FX4X4_STREAM_f32x4(P, R) _mm_stream_ps((f32*) (P), (__m128) (R))
+  #define FX4X4_STREAM_f32x3(P, R) _mm_stream_ps((f32*) (P), (__m128) (R))
+  #define FX4X4_FENCE() _mm_sfence()
+#else
+  #define FX4X4_STREAM_f32x4(P, R) (*(P) = (R))
+  #define FX4X4_STREAM_f32x3(P, R) (*(P) = (R))
+  #define FX4X4_FENCE()
+#endif
+
+#if defined(SOL_GNU) && defined(__AVX__)
+  #define FX4X4_STREAM_f64x4(P, R) _mm256_stream_pd((f64*) (P), (__m256d) (R))
+#elif defined(SOL_GNU) && defined(__SSE2__)
+  #define FX4X4_STREAM_f64x4(P, R)                          \
+    (_mm_stream_pd((f64*) (P), (__m128d) {(R)[0], (R)[1]}), \
+     _mm_stream_pd((f64*) (P) + 2, (__m128d) {(R)[2], (R)[3]}))
+#else
+  #define FX4X4_STREAM_f64x4(P, R) (*(P) = (R))
+#endif
+
+#define FX4X4_STREAM_f64x3 FX4X4_STREAM_f64x4
+
+#if __has_builtin(__builtin_prefetch)
+  #define FX4X4_PREFETCH(P) __builtin_prefetch(P, 0, 3)
+#else
+  #define FX4X4_PREFETCH(P)
+#endif
+
+/*
+** FX4X4_N defines the array form of `F`. Below `SOL_STREAM` bytes of output
+** it is the same loop as the other bulk kernels; above it, each batch of four
+** prefetches the input 1 KiB ahead and bypasses the cache on the way out,
+** since a result that large would only evict the input before anything reads
+** it back. A `dst` that is not aligned to `R` always takes the first loop.
+** `m` is passed by value, so its columns stay in registers.
+*/
+
+#define FX4X4_N(F, R, A, M) \
+SOL_KERNEL(F##_n, (R* dst, M m, const A* v, size_t n), (dst, m, v, n), { \
+  size_t i = 0;                                                    \
+  if (n * sizeof(R) < SOL_STREAM || (uintptr_t) dst % sizeof(R)) { \
+    for (; i + 4 <= n; i += 4) {                                   \
+      const R r0 = F(m, v[i + 0]);                                 \
+      const R r1 = F(m, v[i + 1]);                                 \
+      const R r2 = F(m, v[i + 2]);                                 \
+      const R r3 = F(m, v[i + 3]);                                 \
+      dst[i + 0] = r0;                                             \
+      dst[i + 1] = r1;                                             \
+      dst[i + 2] = r2;                                             \
+      dst[i + 3] = r3;                                             \
+    }                                                              \
+  } else {                                                         \
+    for (; i + 4 <= n; i += 4) {                                   \
+      FX4X4_PREFETCH((const char*) (v + i) + 1024);                \
+      const R r0 = F(m, v[i + 0]);                                 \
+      const R r1 = F(m, v[i + 1]);                                 \
+      const R r2 = F(m, v[i + 2]);                                 \
+      const R r3 = F(m, v[i + 3]);                                 \
+      FX4X4_STREAM_##R(dst + i + 0, r0);                           \
+      FX4X4_STREAM_##R(dst + i + 1, r1);                           \
+      FX4X4_STREAM_##R(dst + i + 2, r2);                           \
+      FX4X4_STREAM_##R(dst + i + 3, r3);                           \
+    }                                                              \
+    FX4X4_FENCE();                                                 \
+  }                                                                \
+  for (; i < n; i++)                                               \
+    dst[i] = F(m, v[i]);                                           \
+})                                                                 \
+SOL_PAR_NF2(F, R, M, A)
+
+/*
+** Definer Macros
+**
+** `M` is column-major: `m.c[j]` is column `j`, so `M_mulv` is a sum of columns
+** scaled by the lanes of `v`, done with `V_fma`. The general inverse follows
+** Lengyel's formulation, which needs only four 3D cross products for the
+** cofactors, using `V3` for the upper three rows.
+*/
+
+#define FX4X4(T, V, M, K, V3) \
+\
+/* Initializers */ \
+\
+_sol_ \
+M M##_set(V c0, V c1, V c2, V c3) { \
+  const M out = {{c0, c1, c2, c3}}; \
+  return out;                       \
+}                                   \
+\
+_sol_ \
+M M##_id(void) {                                            \
+  return M##_set(V##_set(1, 0, 0, 0), V##_set(0, 1, 0, 0),  \
+                 V##_set(0, 0, 1, 0), V##_set(0, 0, 0, 1)); \
+}                                                           \
+\
+/* Matrix Math */ \
+\
+_sol_ \
+V M##_mulv(M m, V v) {                            \
+  const V o = V##_mulf(m.c[0], x(v));             \
+  const V p = V##_fma(m.c[1], V##_setf(y(v)), o); \
+  const V q = V##_fma(m.c[2], V##_setf(z(v)), p); \
+  return V##_fma(m.c[3], V##_setf(w(v)), q);      \
+}                                                 \
+\
+_sol_ \
+M M##_mul(M a, M b) {                  \
+  return M##_set(M##_mulv(a, b.c[0]),  \
+                 M##_mulv(a, b.c[1]),  \
+                 M##_mulv(a, b.c[2]),  \
+                 M##_mulv(a, b.c[3])); \
+}                                      \
+\
+_sol_ \
+M M##_trans(M m) {                                        \
+  M out;                                                  \
+  FX4X4_TRANS(V, K, m.c[0], m.c[1], m.c[2], m.c[3], out); \
+  return out;                                             \
+}                                                         \
+\
+_sol_ \
+T M##_det(M m) {                                                          \
+  const V3 a = V3##_set(x(m.c[0]), y(m.c[0]), z(m.c[0]));                 \
+  const V3 b = V3##_set(x(m.c[1]), y(m.c[1]), z(m.c[1]));                 \
+  const V3 c = V3##_set(x(m.c[2]), y(m.c[2]), z(m.c[2]));                 \
+  const V3 d = V3##_set(x(m.c[3]), y(m.c[3]), z(m.c[3]));                 \
+  const T wa = w(m.c[0]), wb = w(m.c[1]), wc = w(m.c[2]), wd = w(m.c[3]); \
+  const V3 u = V3##_sub(V3##_mulf(a, wb), V3##_mulf(b, wa));              \
+  const V3 v = V3##_sub(V3##_mulf(c, wd), V3##_mulf(d, wc));              \
+  return V3##_dot(V3##_cross(a, b), v) + V3##_dot(V3##_cross(c, d), u);   \
+}                                                                         \
+\
+_sol_ \
+M M##_inv(M m) {                                                          \
+  const V3 a = V3##_set(x(m.c[0]), y(m.c[0]), z(m.c[0]));                 \
+  const V3 b = V3##_set(x(m.c[1]), y(m.c[1]), z(m.c[1]));                 \
+  const V3 c = V3##_set(x(m.c[2]), y(m.c[2]), z(m.c[2]));                 \
+  const V3 d = V3##_set(x(m.c[3]), y(m.c[3]), z(m.c[3]));                 \
+  const T wa = w(m.c[0]), wb = w(m.c[1]), wc = w(m.c[2]), wd = w(m.c[3]); \
+  V3 s = V3##_cross(a, b);                                                \
+  V3 t = V3##_cross(c, d);                                                \
+  V3 u = V3##_sub(V3##_mulf(a, wb), V3##_mulf(b, wa));                    \
+  V3 v = V3##_sub(V3##_mulf(c, wd), V3##_mulf(d, wc));                    \
+  const T inv = (T) 1 / (V3##_dot(s, v) + V3##_dot(t, u));                \
+  s = V3##_mulf(s, inv);                                                  \
+  t = V3##_mulf(t, inv);                                                  \
+  u = V3##_mulf(u, inv);                                                  \
+  v = V3##_mulf(v, inv);                                                  \
+  const V3 r0 = V3##_add(V3##_cross(b, v), V3##_mulf(t, wb));             \
+  const V3 r1 = V3##_sub(V3##_cross(v, a), V3##_mulf(t, wa));             \
+  const V3 r2 = V3##_add(V3##_cross(d, u), V3##_mulf(s, wd));             \
+  const V3 r3 = V3##_sub(V3##_cross(u, c), V3##_mulf(s, wc));             \
+  return M##_trans(M##_set(                                               \
+    V##_set(x(r0), y(r0), z(r0), -V3##_dot(b, t)),                        \
+    V##_set(x(r1), y(r1), z(r1), V3##_dot(a, t)),                         \
+    V##_set(x(r2), y(r2), z(r2), -V3##_dot(d, s)),                        \
+    V##_set(x(r3), y(r3), z(r3), V3##_dot(c, s))));                       \
+}                                                                         \
+\
+_sol_ \
+M M##_inv_affine(M m) {                                   \
+  const V3 a = V3##_set(x(m.c[0]), y(m.c[0]), z(m.c[0])); \
+  const V3 b = V3##_set(x(m.c[1]), y(m.c[1]), z(m.c[1])); \
+  const V3 c = V3##_set(x(m.c[2]), y(m.c[2]), z(m.c[2])); \
+  const V3 d = V3##_set(x(m.c[3]), y(m.c[3]), z(m.c[3])); \
+  const V3 bc = V3##_cross(b, c);                         \
+  const T inv = (T) 1 / V3##_dot(a, bc);                  \
+  const V3 r0 = V3##_mulf(bc, inv);                       \
+  const V3 r1 = V3##_mulf(V3##_cross(c, a), inv);         \
+  const V3 r2 = V3##_mulf(V3##_cross(a, b), inv);         \
+  return M##_trans(M##_set(                               \
+    V##_set(x(r0), y(r0), z(r0), -V3##_dot(r0, d)),       \
+    V##_set(x(r1), y(r1), z(r1), -V3##_dot(r1, d)),       \
+    V##_set(x(r2), y(r2), z(r2), -V3##_dot(r2, d)),       \
+    V##_set(0, 0, 0, 1)));                                \
+}                                                         \
+\
+_sol_ \
+V3 M##_mulp(M m, V3 p) {                                    \
+  const V o = V##_fma(m.c[0], V##_setf(x(p)), m.c[3]);      \
+  const V q = V##_fma(m.c[1], V##_setf(y(p)), o);           \
+  return FX4X4_XYZ(V3, V##_fma(m.c[2], V##_setf(z(p)), q)); \
+}                                                           \
+\
+/* Bulk Math */ \
+\
+FX4X4_N(M##_mulv, V, V, M) \
+FX4X4_N(M##_mulp, V3, V3, M)
+
+FX4X4(f32, f32x4, f32x4x4, u32x4, f32x3)
+FX4X4(f64, f64x4, f64x4x4, u64x4, f64x3)
+
+#undef FX4X4
+#undef FX4X4_TRANS
+#undef FX4X4_SHUF
+#undef FX4X4_XYZ
+#undef FX4X4_STREAM_f32x4
+#undef FX4X4_STREAM_f32x3
+#undef FX4X4_STREAM_f64x4
+#undef FX4X4_STREAM_f64x3
+#undef FX4X4_FENCE
+#undef FX4X4_PREFETCH
+#undef FX4X4_N
+
+#endif /* SOL_FX4X4_H */
@@ -0,0 +1,194 @@
+/*
+** fx8.h | The Sol Vector Library | Code for f32x8 and f64x8.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_FX8_H
+#define SOL_FX8_H
+
+/*
+** Without GNU vectors the operators are loops over `vec` that assign into `O`,
+** since an initializer would have to spell out every lane.
+*/
+
+#ifdef SOL_GNU
+  #define FX8_OP(O, A, OP, B) O = A OP B
+  #define FX8_OPF(O, V, OP, F) O = V OP F
+  #define FX8_FOP(O, F, OP, V) O = F OP V
+  #define FX8_OP2(O, A, AB, B, BC, C) O = (A AB B) BC C
+#else
+  #define FX8_OP(O, A, OP, B) \
+    for (size_t i = 0; i < 8; i++) vec(O)[i] = vec(A)[i] OP vec(B)[i]
+  #define FX8_OPF(O, V, OP, F) \
+    for (size_t i = 0; i < 8; i++) vec(O)[i] = vec(V)[i] OP F
+  #define FX8_FOP(O, F, OP, V) \
+    for (size_t i = 0; i < 8; i++) vec(O)[i] = F OP vec(V)[i]
+  #define FX8_OP2(O, A, AB, B, BC, C) \
+    for (size_t i = 0; i < 8; i++) vec(O)[i] = (vec(A)[i] AB vec(B)[i]) BC vec(C)[i]
+#endif
+
+#define FX8(T, V) \
+\
+/* Initializers */ \
+\
+_sol_ \
+V V##_set(T l0, T l1, T l2, T l3, T l4, T l5, T l6, T l7) { \
+  const T l[8] = {l0, l1, l2, l3, l4, l5, l6, l7};          \
+  V out;                                                    \
+  memcpy(&out, l, sizeof out);                              \
+  return out;                                               \
+}                                                           \
+\
+_sol_ \
+V V##_setf(T f) {                \
+  V out;                         \
+  for (size_t i = 0; i < 8; i++) \
+    vec(out)[i] = f;             \
+  return out;                    \
+}                                \
+\
+_sol_ \
+V V##_zero(void) {        \
+  return V##_setf((T) 0); \
+}                         \
+\
+_sol_ \
+V V##_load(const T* p) {       \
+  V out;                       \
+  memcpy(&out, p, sizeof out); \
+  return out;                  \
+}                              \
+\
+_sol_ \
+void V##_store(T* p, V v) { \
+  memcpy(p, &v, sizeof v);  \
+}                           \
+\
+/* Basic Math */ \
+\
+_sol_ \
+T V##_sum(V v) {                 \
+  T out = 0;                     \
+  for (size_t i = 0; i < 8; i++) \
+    out += vec(v)[i];            \
+  return out;                    \
+}                                \
+\
+_sol_ \
+V V##_sq(V v) {         \
+  return V##_mul(v, v); \
+}                       \
+\
+_sol_ \
+V V##_add(V a, V b) {   \
+  V out;                \
+  FX8_OP(out, a, +, b); \
+  return out;           \
+}                       \
+\
+_sol_ \
+V V##_addf(V v, T f) {   \
+  V out;                 \
+  FX8_OPF(out, v, +, f); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_sub(V a, V b) {   \
+  V out;                \
+  FX8_OP(out, a, -, b); \
+  return out;           \
+}                       \
+\
+_sol_ \
+V V##_subf(V v, T f) {   \
+  V out;                 \
+  FX8_OPF(out, v, -, f); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_fsub(T f, V v) {   \
+  V out;                 \
+  FX8_FOP(out, f, -, v); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_mul(V a, V b) {   \
+  V out;                \
+  FX8_OP(out, a, *, b); \
+  return out;           \
+}                       \
+\
+_sol_ \
+V V##_mulf(V v, T f) {   \
+  V out;                 \
+  FX8_OPF(out, v, *, f); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_div(V a, V b) {   \
+  V out;                \
+  FX8_OP(out, a, /, b); \
+  return out;           \
+}                       \
+\
+_sol_ \
+V V##_divf(V v, T f) {   \
+  V out;                 \
+  FX8_OPF(out, v, /, f); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_fdiv(T f, V v) {   \
+  V out;                 \
+  FX8_FOP(out, f, /, v); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_fma(V a, V b, V c) {     \
+  FMA_##T(V, a, b, c, false)   \
+  V out;                       \
+  FX8_OP2(out, a, *, b, +, c); \
+  return out;                  \
+}                              \
+\
+_sol_ \
+V V##_fms(V a, V b, V c) {     \
+  FMA_##T(V, a, b, c, true)    \
+  V out;                       \
+  FX8_OP2(out, a, *, b, -, c); \
+  return out;                  \
+}                              \
+\
+/* Bulk Kernels */ \
+\
+SOL_N1(V##_sum, T, V) \
+SOL_N1(V##_sq, V, V) \
+SOL_N2(V##_add, V, V) \
+SOL_N2F(V##_addf, V, V, T, f) \
+SOL_N2(V##_sub, V, V) \
+SOL_N2F(V##_subf, V, V, T, f) \
+SOL_NF2(V##_fsub, V, T, V) \
+SOL_N2(V##_mul, V, V) \
+SOL_N2F(V##_mulf, V, V, T, f) \
+SOL_N2(V##_div, V, V) \
+SOL_N2F(V##_divf, V, V, T, f) \
+SOL_NF2(V##_fdiv, V, T, V) \
+SOL_N3(V##_fma, V, V) \
+SOL_N3(V##_fms, V, V)
+
+FX8(f32, f32x8)
+FX8(f64, f64x8)
+
+#undef FX8
+#undef FX8_OP
+#undef FX8_OPF
+#undef FX8_FOP
+#undef FX8_OP2
+
+#endif /* SOL_FX8_H */
@@ -0,0 +1,157 @@
+/*
+** fxl.h | The Sol Vector Library | Code for f32l and f64l.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_FXL_H
+#define SOL_FXL_H
+
+/*
+** Convenience Macros
+*/
+
+#ifdef SOL_GNU
+  #ifdef __AVX__
+    #define FXL_SQRT(T, L, V)                                \
+      V = (sizeof(T) == 8) ? (L) _mm256_sqrt_pd((__m256d) V) \
+                           : (L) _mm256_sqrt_ps((__m256) V)
+  #else
+    #define FXL_SQRT(T, L, V)            \
+      for (size_t i = 0; i < L##_w; i++) \
+        V[i] = T##_sqrt(V[i])
+  #endif
+#else
+  #define FXL_SQRT(T, L, V) V = T##_sqrt(V)
+#endif
+
+#if defined(SOL_GNU) && defined(__AVX__)
+  /*
+  ** The f64 lanes split off their exponents like FX1_f64_rsqrt does. If any
+  ** lane has no split (zero, subnormal, negative, infinity or NaN), all four
+  ** go through f64_rsqrt instead. The f32 lanes take the estimate, and where any lane is
+  ** zero, subnormal, negative, infinite or NaN (the FX1_f32_edge test) those
+  ** lanes are blended over with `1 / sqrt`.
+  */
+
+  _sol_
+  f64l FXL_f64l_rsqrt(f64l v) {
+    u64l u;
+    memcpy(&u, &v, sizeof u);
+    const u64l edge = (u64l) (u - 0x0010000000000000 >= 0x7fe0000000000000);
+    if (edge[0] | edge[1] | edge[2] | edge[3]) {
+      for (size_t i = 0; i < f64l_w; i++)
+        v[i] = f64_rsqrt(v[i]);
+      return v;
+    }
+    const u64l e = u >> 52;
+    const u64l odd = (e & 1) ^ 1;
+    const u64l mu = (u & 0x000fffffffffffff) | ((1023 + odd) << 52);
+    const u64l su = ((3069 - e + odd) >> 1) << 52;
+    f64l m, scale;
+    memcpy(&m, &mu, sizeof m);
+    memcpy(&scale, &su, sizeof scale);
+    const __m128 g = _mm_rsqrt_ps(_mm256_cvtpd_ps((__m256d) m));
+    const f64l y = (f64l) _mm256_cvtps_pd(g) * scale;
+    return y * (1.5 - 0.5 * v * y * y);
+  }
+
+  _sol_
+  f32l FXL_f32l_rsqrt(f32l v) {
+    u32l u;
+    memcpy(&u, &v, sizeof u);
+    const u32l edge = (u32l) (u - 0x00800000 >= 0x7f000000);
+    const f32l y = (f32l) _mm256_rsqrt_ps((__m256) v);
+    const f32l out = y * (1.5f - 0.5f * v * y * y);
+    if (_mm256_testz_si256((__m256i) edge, (__m256i) edge))
+      return out;
+    const f32l full = 1.0f / (f32l) _mm256_sqrt_ps((__m256) v);
+    return (f32l) (((u32l) full & edge) | ((u32l) out & ~edge));
+  }
+
+  #define FXL_RSQRT(T, L, V) {                     \
+    if (sizeof(T) == 8)                            \
+      V = (L) FXL_f64l_rsqrt((f64l) V);            \
+    else                                           \
+      V = (L) FXL_f32l_rsqrt((f32l) V);            \
+  }
+#elif defined(SOL_GNU)
+  #define FXL_RSQRT(T, L, V)           \
+    for (size_t i = 0; i < L##_w; i++) \
+      V[i] = T##_rsqrt(V[i])
+#else
+  #define FXL_RSQRT(T, L, V) V = T##_rsqrt(V)
+#endif
+
+/*
+** Definer Macros
+*/
+
+#define FXL(T, L) \
+\
+/* Initializers */ \
+\
+_sol_ \
+L L##_setf(T f) {     \
+  const L zero = {0}; \
+  return zero + f;    \
+}                     \
+\
+/* Memory */ \
+\
+_sol_ \
+L L##_load(const T* p) {      \
+  L out;                      \
+  memcpy(&out, p, sizeof(L)); \
+  return out;                 \
+}                             \
+\
+_sol_ \
+L L##_loadn(const T* p, size_t n) { \
+  L out = L##_setf(0);              \
+  memcpy(&out, p, n * sizeof(T));   \
+  return out;                       \
+}                                   \
+\
+_sol_ \
+void L##_store(T* p, L v) { \
+  memcpy(p, &v, sizeof(L)); \
+}                           \
+\
+_sol_ \
+void L##_storen(T* p, L v, size_t n) { \
+  memcpy(p, &v, n * sizeof(T));        \
+}                                      \
+\
+/* Math */ \
+\
+_sol_ \
+L L##_sqrt(L v) {    \
+  FXL_SQRT(T, L, v); \
+  return v;          \
+}                    \
+\
+_sol_ \
+L L##_rsqrt(L v) {    \
+  FXL_RSQRT(T, L, v); \
+  return v;           \
+}                     \
+\
+/* Bulk Kernels */ \
+\
+SOL_KERNEL(T##_rsqrt_n, (T* dst, const T* v, size_t n), (dst, v, n), { \
+  size_t i = 0;                                                     \
+  for (; i + L##_w <= n; i += L##_w)                                \
+    L##_store(dst + i, L##_rsqrt(L##_load(v + i)));                 \
+  if (i < n)                                                        \
+    L##_storen(dst + i, L##_rsqrt(L##_loadn(v + i, n - i)), n - i); \
+})                                                                  \
+SOL_PAR_N1(T##_rsqrt, T, T)
+
+FXL(f32, f32l)
+FXL(f64, f64l)
+
+#undef FXL
+#undef FXL_SQRT
+#undef FXL_RSQRT
+
+#endif /* SOL_FXL_H */
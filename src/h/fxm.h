@@ -0,0 +1,430 @@
+/*
+** fxm.h | The Sol Vector Library | Lane-wise math for f32x4, f64x4, f32l and f64l.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_FXM_H
+#define SOL_FXM_H
+
+/*
+** Convenience Macros
+**
+** The kernels below are written once against "lane" types that are either
+** GNU vectors or plain scalars, picked per instance by `P` (GNU or SCALAR).
+** `AS` reinterprets the bits of a lane as another lane type of the same size,
+** `CVT` converts lane values, `MASK` turns a comparison into an all-ones or
+** all-zeroes mask, `ANY` asks whether a mask has any lane set, and `SEL` picks
+** between two lanes with such a mask.
+**
+** FXM_TRIG_MAX is where the sincos kernel stops being accurate (see below).
+** Lanes past it, and infinity and NaN, are zeroed before the kernel runs and
+** then redone one at a time by FXM_T_sincos_far, which is kept out of line.
+*/
+
+#define FXM_TRIG_MAX(T) ((sizeof(T) == 8) ? (T) 1e9 : (T) 1e4)
+
+#ifdef __GNUC__
+  #define FXM_COLD static __attribute__((noinline, unused))
+#else
+  #define FXM_COLD static inline
+#endif
+
+#define FXM_GNU_AS(A, B, X) ((B) (X))
+#define FXM_GNU_CVT(X, U) __builtin_convertvector(X, U)
+#define FXM_GNU_MASK(M, X) ((M) (X))
+#define FXM_SCALAR_AS(A, B, X) FXM_##A##_as_##B(X)
+#define FXM_SCALAR_CVT(X, U) ((U) (X))
+#define FXM_GNU_ANY(M, X) FXM_##M##_any(X)
+#define FXM_SCALAR_MASK(M, X) ((M) 0 - (M) (X))
+#define FXM_SCALAR_ANY(M, X) ((X) != 0)
+
+#define FXM_SEL(P, V, M, m, a, b)                 \
+  FXM_##P##_AS(M, V, (FXM_##P##_AS(V, M, a) & (m)) \
+                   | (FXM_##P##_AS(V, M, b) & ~(m)))
+
+#define FXM_BITCAST(A, B)   \
+_sol_                       \
+B FXM_##A##_as_##B(A a) {   \
+  B b;                      \
+  memcpy(&b, &a, sizeof b); \
+  return b;                 \
+}
+
+FXM_BITCAST(f32, u32)
+FXM_BITCAST(u32, f32)
+FXM_BITCAST(f64, u64)
+FXM_BITCAST(u64, f64)
+
+#ifdef SOL_GNU
+  #ifdef __AVX__
+    _sol_
+    f32x4 FXM_f32x4_sqrt(f32x4 v) {
+      return (f32x4) _mm_sqrt_ps((__m128) v);
+    }
+
+    _sol_
+    f64x4 FXM_f64x4_sqrt(f64x4 v) {
+      return (f64x4) _mm256_sqrt_pd((__m256d) v);
+    }
+  #else
+    _sol_
+    f32x4 FXM_f32x4_sqrt(f32x4 v) {
+      for (size_t i = 0; i < 4; i++)
+        v[i] = f32_sqrt(v[i]);
+      return v;
+    }
+
+    _sol_
+    f64x4 FXM_f64x4_sqrt(f64x4 v) {
+      for (size_t i = 0; i < 4; i++)
+        v[i] = f64_sqrt(v[i]);
+      return v;
+    }
+  #endif
+#else
+  FXM_BITCAST(f32l, u32l)
+  FXM_BITCAST(u32l, f32l)
+  FXM_BITCAST(f64l, u64l)
+  FXM_BITCAST(u64l, f64l)
+#endif
+
+#undef FXM_BITCAST
+
+#ifdef SOL_GNU
+  #define FXM_ANY(M)                                      \
+  _sol_                                                   \
+  bool FXM_##M##_any(M m) {                               \
+    u64 any = 0;                                          \
+    for (size_t i = 0; i < sizeof(M) / sizeof(m[0]); i++) \
+      any |= m[i];                                        \
+    return any != 0;                                      \
+  }
+
+  FXM_ANY(u32x4)
+  FXM_ANY(u64x4)
+  FXM_ANY(u32l)
+  FXM_ANY(u64l)
+
+  #undef FXM_ANY
+#endif
+
+#define FXM_FAR(T)                                               \
+FXM_COLD                                                         \
+void FXM_##T##_sincos_far(const T* v, T* s, T* c, size_t n) {    \
+  for (size_t i = 0; i < n; i++)                                 \
+    if (!(T##_abs(v[i]) <= FXM_TRIG_MAX(T)))                     \
+      T##_sincos_precise(v[i], s + i, c + i);                    \
+}
+
+FXM_FAR(f32)
+FXM_FAR(f64)
+
+#undef FXM_FAR
+
+/*
+** Definer Macros
+**
+** `V` is the float lane type, `K` an i32 lane type with as many lanes, and `M`
+** an unsigned lane type as wide as `V`, used for masks and sign bits. `N` is
+** the name of the kernel, so each can be instantiated for scalars too.
+**
+** sincos reduces `v` to `r` in [-pi/4, pi/4] with `v = k * pi/2 + r`, taking
+** pi/2 in three parts (Cody-Waite) so `r` stays accurate for large `k`, then
+** evaluates minimax polynomials for both sin(r) and cos(r). The low two bits
+** of `k` pick which polynomial goes where and which signs to flip, all with
+** masks instead of branches. Results are within a few ULP for |v| below
+** FXM_TRIG_MAX, 1e4 (f32) or 1e9 (f64).
+**
+** atan2 divides the smaller of |y| and |x| by the larger, so `t` is in [0, 1],
+** and folds `t` past tan(pi/8) onto pi/4 + atan((t - 1) / (t + 1)). What is
+** left is a polynomial on [-0.4142, 0.4142] (cephes for f32, fdlibm for f64),
+** and the octant and quadrant fixups are masked additions of pi/4, pi/2 and
+** pi, each split into a high and a low part. asin, acos and atan are atan2 on
+** (v, sqrt(1 - v^2)), (sqrt(1 - v^2), v) and (v, 1), with 1 - v^2 factored as
+** (1 - v)(1 + v) so it stays exact near |v| = 1.
+*/
+
+#define FXM_SINCOS(N, T, V, K, M, P) \
+\
+_sol_ \
+void N(V v, V* s, V* c) {                                                          \
+  const M sign = FXM_##P##_AS(V, M, v) & (((M) {0} + 1) << (sizeof(T) * 8 - 1));   \
+  const V half = FXM_##P##_AS(M, V, FXM_##P##_AS(V, M, (V) {0} + (T) 0.5) | sign); \
+  const K k = FXM_##P##_CVT(v * (T) 0.63661977236758134308 + half, K);             \
+  const V kf = FXM_##P##_CVT(k, V);                                                \
+  V r, r2, sp, cp;                                                                 \
+  if (sizeof(T) == 8) {                                                            \
+    r = v - kf * (T) 1.57079632673412561417e+00;                                   \
+    r = r - kf * (T) 6.07710050630396597660e-11;                                   \
+    r = r - kf * (T) 2.02226624871116645580e-21;                                   \
+    r2 = r * r;                                                                    \
+    sp = r2 * (T) 1.58969099521155010221e-10 + (T) -2.50507602534068634195e-08;    \
+    sp = sp * r2 + (T) 2.75573137070700676789e-06;                                 \
+    sp = sp * r2 + (T) -1.98412698298579493134e-04;                                \
+    sp = sp * r2 + (T) 8.33333333332248946124e-03;                                 \
+    sp = sp * r2 + (T) -1.66666666666666324348e-01;                                \
+    cp = r2 * (T) -1.13596475577881948265e-11 + (T) 2.08757232129817482790e-09;    \
+    cp = cp * r2 + (T) -2.75573143513906633035e-07;                                \
+    cp = cp * r2 + (T) 2.48015872894767294178e-05;                                 \
+    cp = cp * r2 + (T) -1.38888888888741095749e-03;                                \
+    cp = cp * r2 + (T) 4.16666666666666019037e-02;                                 \
+  } else {                                                                         \
+    r = v - kf * (T) 1.5703125f;                                                   \
+    r = r - kf * (T) 4.837512969970703125e-4f;                                     \
+    r = r - kf * (T) 7.54978995489188216e-8f;                                      \
+    r2 = r * r;                                                                    \
+    sp = r2 * (T) -1.9515295891e-4f + (T) 8.3321608736e-3f;                        \
+    sp = sp * r2 + (T) -1.6666654611e-1f;                                          \
+    cp = r2 * (T) 2.443315711809948e-5f + (T) -1.388731625493765e-3f;              \
+    cp = cp * r2 + (T) 4.166664568298827e-2f;                                      \
+  }                                                                                \
+  sp = r + r * r2 * sp;                                                            \
+  cp = (T) 1.0 - (T) 0.5 * r2 + r2 * r2 * cp;                                      \
+  const M q = FXM_##P##_CVT(k, M);                                                 \
+  const M swap = (M) {0} - (q & 1);                                                \
+  const M ssin = (q & 2) << (sizeof(T) * 8 - 2);                                   \
+  const M scos = ((q + 1) & 2) << (sizeof(T) * 8 - 2);                             \
+  const M ms = FXM_##P##_AS(V, M, sp);                                             \
+  const M mc = FXM_##P##_AS(V, M, cp);                                             \
+  *s = FXM_##P##_AS(M, V, ((mc & swap) | (ms & ~swap)) ^ ssin);                    \
+  *c = FXM_##P##_AS(M, V, ((ms & swap) | (mc & ~swap)) ^ scos);                    \
+}
+
+#define FXM_ATAN2(N, T, V, M, P) \
+\
+_sol_ \
+V N(V y, V x) {                                                                   \
+  const M sbit = ((M) {0} + 1) << (sizeof(T) * 8 - 1);                            \
+  const M uy = FXM_##P##_AS(V, M, y);                                             \
+  const M ux = FXM_##P##_AS(V, M, x);                                             \
+  const V ay = FXM_##P##_AS(M, V, uy & ~sbit);                                    \
+  const V ax = FXM_##P##_AS(M, V, ux & ~sbit);                                    \
+  const M swap = FXM_##P##_MASK(M, ay > ax);                                      \
+  const V hi = FXM_SEL(P, V, M, swap, ay, ax);                                    \
+  const V lo = FXM_SEL(P, V, M, swap, ax, ay);                                    \
+  const M zero = FXM_##P##_MASK(M, hi == (V) {0});                                \
+  const V t = FXM_##P##_AS(M, V, FXM_##P##_AS(V, M, lo / hi) & ~zero);            \
+  const M fold = FXM_##P##_MASK(M, t > (T) 0.41421356237309504880);               \
+  const V c = FXM_##P##_AS(M, V, fold & FXM_##P##_AS(V, M, (V) {0} + (T) 1));     \
+  const V u = (t - c) / (t * c + (T) 1);                                          \
+  const V z = u * u;                                                              \
+  V p, pi4h, pi4l, pi2h, pi2l, pih, pil;                                          \
+  if (sizeof(T) == 8) {                                                           \
+    const V w = z * z;                                                            \
+    V s1 = w * (T) 1.62858201153657823623e-02 + (T) 4.97687799461593236017e-02;   \
+    s1 = s1 * w + (T) 6.66107313738753120669e-02;                                 \
+    s1 = s1 * w + (T) 9.09088713343650656196e-02;                                 \
+    s1 = s1 * w + (T) 1.42857142725034663711e-01;                                 \
+    s1 = s1 * w + (T) 3.33333333333329318027e-01;                                 \
+    V s2 = w * (T) -3.65315727442169155270e-02 + (T) -5.83357013379057348645e-02; \
+    s2 = s2 * w + (T) -7.69187620504482999495e-02;                                \
+    s2 = s2 * w + (T) -1.11111104054623557880e-01;                                \
+    s2 = s2 * w + (T) -1.99999999998764832476e-01;                                \
+    p = u - u * (z * s1 + w * s2);                                                \
+    pi4h = c * (T) 7.85398163397448278999e-01;                                    \
+    pi4l = c * (T) 3.06161699786838301793e-17;                                    \
+    pi2h = (V) {0} + (T) 1.57079632679489655800e+00;                              \
+    pi2l = (V) {0} + (T) 6.12323399573676603587e-17;                              \
+    pih = (V) {0} + (T) 3.14159265358979311600e+00;                               \
+    pil = (V) {0} + (T) 1.22464679914735317720e-16;                               \
+  } else {                                                                        \
+    p = z * (T) 8.05374449538e-2f + (T) -1.38776856032e-1f;                       \
+    p = p * z + (T) 1.99777106478e-1f;                                            \
+    p = p * z + (T) -3.33329491539e-1f;                                           \
+    p = u + u * z * p;                                                            \
+    pi4h = c * (T) 7.85398185253143310547e-01f;                                   \
+    pi4l = c * (T) -2.18556950009312130000e-08f;                                  \
+    pi2h = (V) {0} + (T) 1.57079637050628662109e+00f;                             \
+    pi2l = (V) {0} + (T) -4.37113900018624260000e-08f;                            \
+    pih = (V) {0} + (T) 3.14159274101257324219e+00f;                              \
+    pil = (V) {0} + (T) -8.74227800037248500000e-08f;                             \
+  }                                                                               \
+  V r = pi4h + (p + pi4l);                                                        \
+  r = FXM_SEL(P, V, M, swap, pi2h - r + pi2l, r);                                 \
+  r = FXM_SEL(P, V, M, (M) {0} - (ux >> (sizeof(T) * 8 - 1)), pih - r + pil, r);  \
+  return FXM_##P##_AS(M, V, FXM_##P##_AS(V, M, r) | (uy & sbit));                 \
+}
+
+#define FXM_ATANS(T, V, SQRT) \
+\
+_sol_ \
+V V##_atan(V v) {                       \
+  return V##_atan2(v, (V) {0} + (T) 1); \
+}                                       \
+\
+_sol_ \
+V V##_asin(V v) {                                       \
+  return V##_atan2(v, SQRT(((T) 1 - v) * ((T) 1 + v))); \
+}                                                       \
+\
+_sol_ \
+V V##_acos(V v) {                                       \
+  return V##_atan2(SQRT(((T) 1 - v) * ((T) 1 + v)), v); \
+}
+
+#define FXM(T, V, K, M, P, SQRT) \
+\
+FXM_SINCOS(FXM_##V##_sincos, T, V, K, M, P) \
+FXM_ATAN2(V##_atan2, T, V, M, P)            \
+FXM_ATANS(T, V, SQRT)                       \
+\
+_sol_ \
+void V##_sincos(V v, V* s, V* c) {                                      \
+  const M sbit = ((M) {0} + 1) << (sizeof(T) * 8 - 1);                  \
+  const V a = FXM_##P##_AS(M, V, FXM_##P##_AS(V, M, v) & ~sbit);        \
+  const M far = FXM_##P##_MASK(M, (a > FXM_TRIG_MAX(T)) | (a != a));    \
+  FXM_##V##_sincos(FXM_SEL(P, V, M, far, (V) {0}, v), s, c);            \
+  if (FXM_##P##_ANY(M, far))                                            \
+    FXM_##T##_sincos_far((const T*) (const void*) &v, (T*) (void*) s,   \
+                         (T*) (void*) c, sizeof(V) / sizeof(T));        \
+}                                                                       \
+\
+_sol_ \
+V V##_sin(V v) {         \
+  V s, c;                \
+  V##_sincos(v, &s, &c); \
+  return s;              \
+}                        \
+\
+_sol_ \
+V V##_cos(V v) {         \
+  V s, c;                \
+  V##_sincos(v, &s, &c); \
+  return c;              \
+}                        \
+\
+_sol_ \
+V V##_tan(V v) {         \
+  V s, c;                \
+  V##_sincos(v, &s, &c); \
+  return s / c;          \
+}
+
+/*
+** Without GNU vectors, f32l and f64l are scalars and the 4-wide types are
+** structs, which are handled a lane at a time.
+*/
+
+#define FXM_LANES(V, L) \
+\
+_sol_ \
+void V##_sincos(V v, V* s, V* c) {  \
+  L sx, sy, sz, sw, cx, cy, cz, cw; \
+  L##_sincos(x(v), &sx, &cx);       \
+  L##_sincos(y(v), &sy, &cy);       \
+  L##_sincos(z(v), &sz, &cz);       \
+  L##_sincos(w(v), &sw, &cw);       \
+  *s = V##_set(sx, sy, sz, sw);     \
+  *c = V##_set(cx, cy, cz, cw);     \
+}                                   \
+\
+_sol_ \
+V V##_atan2(V a, V b) {                                         \
+  return V##_set(L##_atan2(x(a), x(b)), L##_atan2(y(a), y(b)),  \
+                 L##_atan2(z(a), z(b)), L##_atan2(w(a), w(b))); \
+}                                                               \
+\
+_sol_ \
+V V##_atan(V v) {                                                                 \
+  return V##_set(L##_atan(x(v)), L##_atan(y(v)), L##_atan(z(v)), L##_atan(w(v))); \
+}                                                                                 \
+\
+_sol_ \
+V V##_asin(V v) {                                                                 \
+  return V##_set(L##_asin(x(v)), L##_asin(y(v)), L##_asin(z(v)), L##_asin(w(v))); \
+}                                                                                 \
+\
+_sol_ \
+V V##_acos(V v) {                                                                 \
+  return V##_set(L##_acos(x(v)), L##_acos(y(v)), L##_acos(z(v)), L##_acos(w(v))); \
+}                                                                                 \
+\
+_sol_ \
+V V##_sin(V v) {         \
+  V s, c;                \
+  V##_sincos(v, &s, &c); \
+  return s;              \
+}                        \
+\
+_sol_ \
+V V##_cos(V v) {         \
+  V s, c;                \
+  V##_sincos(v, &s, &c); \
+  return c;              \
+}                        \
+\
+_sol_ \
+V V##_tan(V v) {         \
+  V s, c;                \
+  V##_sincos(v, &s, &c); \
+  return V##_div(s, c);  \
+}
+
+#ifdef SOL_GNU
+  FXM(f32, f32x4, i32x4, u32x4, GNU, FXM_f32x4_sqrt)
+  FXM(f64, f64x4, i32x4, u64x4, GNU, FXM_f64x4_sqrt)
+  FXM(f32, f32l, i32l, u32l, GNU, f32l_sqrt)
+  FXM(f64, f64l, i32x4, u64l, GNU, f64l_sqrt)
+#else
+  FXM(f32, f32l, i32l, u32l, SCALAR, f32l_sqrt)
+  FXM(f64, f64l, i32l, u64l, SCALAR, f64l_sqrt)
+  FXM_LANES(f32x4, f32l)
+  FXM_LANES(f64x4, f64l)
+#endif
+
+/*
+** Scalar Kernels
+**
+** The precise scalar tier runs the same kernel on a single f64. Past 1e9 the
+** three-part reduction runs out of bits (and `k` out of i32), so those go to
+** libm, which does a full Payne-Hanek reduction. f32 is evaluated in f64 and
+** rounded once, which is correctly rounded for all but a handful of inputs.
+*/
+
+FXM_SINCOS(FXM_f64_sincos, f64, f64, i32, u64, SCALAR)
+
+_sol_
+void f64_sincos_precise(f64 f, f64* s, f64* c) {
+  if (f64_abs(f) < 1e9) {
+    FXM_f64_sincos(f, s, c);
+  } else {
+    *s = sin(f);
+    *c = cos(f);
+  }
+}
+
+_sol_
+void f32_sincos_precise(f32 f, f32* s, f32* c) {
+  f64 ds, dc;
+  f64_sincos_precise((f64) f, &ds, &dc);
+  *s = (f32) ds;
+  *c = (f32) dc;
+}
+
+/*
+** The scalar inverse trig functions are the lane kernels on one lane.
+*/
+
+FXM_ATAN2(f32_atan2, f32, f32, u32, SCALAR)
+FXM_ATAN2(f64_atan2, f64, f64, u64, SCALAR)
+FXM_ATANS(f32, f32, f32_sqrt)
+FXM_ATANS(f64, f64, f64_sqrt)
+
+#undef FXM_SINCOS
+#undef FXM_TRIG_MAX
+#undef FXM_COLD
+#undef FXM_GNU_ANY
+#undef FXM_SCALAR_ANY
+#undef FXM_ATAN2
+#undef FXM_ATANS
+#undef FXM
+#undef FXM_LANES
+#undef FXM_SEL
+#undef FXM_GNU_AS
+#undef FXM_GNU_CVT
+#undef FXM_GNU_MASK
+#undef FXM_SCALAR_AS
+#undef FXM_SCALAR_CVT
+#undef FXM_SCALAR_MASK
+
+#endif /* SOL_FXM_H */
@@ -0,0 +1,161 @@
+/*
+** fxq.h | The Sol Vector Library | Quaternion code for f32x4 and f64x4.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_FXQ_H
+#define SOL_FXQ_H
+
+/*
+** Bulk Definers
+**
+** FXQ_N2 and FXQ_N2F are SOL_N2 and SOL_N2F for functions whose two array
+** arguments have different types, or which also take a shared `P`.
+*/
+
+#define FXQ_N2(F, R, A, B) \
+SOL_KERNEL(F##_n, (R* dst, const A* a, const B* b, size_t n), (dst, a, b, n), { \
+  size_t i = 0;                         \
+  for (; i + 4 <= n; i += 4) {          \
+    const R r0 = F(a[i + 0], b[i + 0]); \
+    const R r1 = F(a[i + 1], b[i + 1]); \
+    const R r2 = F(a[i + 2], b[i + 2]); \
+    const R r3 = F(a[i + 3], b[i + 3]); \
+    dst[i + 0] = r0;                    \
+    dst[i + 1] = r1;                    \
+    dst[i + 2] = r2;                    \
+    dst[i + 3] = r3;                    \
+  }                                     \
+  for (; i < n; i++)                    \
+    dst[i] = F(a[i], b[i]);             \
+})                                      \
+SOL_PAR_N2(F, R, A, B)
+
+#define FXQ_N2F(F, R, A, S, P) \
+SOL_KERNEL(F##_n, (R* dst, const A* a, const A* b, S P, size_t n), (dst, a, b, P, n), { \
+  size_t i = 0;                            \
+  for (; i + 4 <= n; i += 4) {             \
+    const R r0 = F(a[i + 0], b[i + 0], P); \
+    const R r1 = F(a[i + 1], b[i + 1], P); \
+    const R r2 = F(a[i + 2], b[i + 2], P); \
+    const R r3 = F(a[i + 3], b[i + 3], P); \
+    dst[i + 0] = r0;                       \
+    dst[i + 1] = r1;                       \
+    dst[i + 2] = r2;                       \
+    dst[i + 3] = r3;                       \
+  }                                        \
+  for (; i < n; i++)                       \
+    dst[i] = F(a[i], b[i], P);             \
+})                                         \
+SOL_PAR_N3F(F, R, A, S)
+
+/*
+** Definer Macros
+**
+** A quaternion is a `V` holding (x, y, z, w) with `w` as the real part, the
+** same layout `Tx3_rot` takes. `V_qmul(a, b)` rotates by `b` and then by `a`.
+** Only `V_qinv` handles quaternions that are not unit length.
+*/
+
+#define FXQ(T, V, V3, M, M3) \
+\
+/* Initializers */ \
+\
+_sol_ \
+V V##_qid(void) {             \
+  return V##_set(0, 0, 0, 1); \
+}                             \
+\
+_sol_ \
+V V##_qaxis(V3 axis, T rad) {                               \
+  T s, c;                                                   \
+  T##_sincos_precise(rad / 2, &s, &c);                      \
+  return V##_set(x(axis) * s, y(axis) * s, z(axis) * s, c); \
+}                                                           \
+\
+/* Quaternion Math */ \
+\
+_sol_ \
+V V##_qmul(V a, V b) {                                                       \
+  const V o = V##_mulf(b, w(a));                                             \
+  const V p = V##_fma(V##_set(w(b), -z(b), y(b), -x(b)), V##_setf(x(a)), o); \
+  const V q = V##_fma(V##_set(z(b), w(b), -x(b), -y(b)), V##_setf(y(a)), p); \
+  return V##_fma(V##_set(-y(b), x(b), w(b), -z(b)), V##_setf(z(a)), q);      \
+}                                                                            \
+\
+_sol_ \
+V V##_qconj(V q) {                           \
+  return V##_set(-x(q), -y(q), -z(q), w(q)); \
+}                                            \
+\
+_sol_ \
+V V##_qinv(V q) {                                    \
+  return V##_divf(V##_qconj(q), V##_sum(V##_sq(q))); \
+}                                                    \
+\
+_sol_ \
+V3 V##_qrot(V q, V3 v) { \
+  return V3##_rot(v, q); \
+}                        \
+\
+_sol_ \
+V V##_qnlerp(V a, V b, T t) {                                   \
+  const T s = (V##_sum(V##_mul(a, b)) < 0) ? -t : t;            \
+  return V##_norm(V##_fma(b, V##_setf(s), V##_mulf(a, 1 - t))); \
+}                                                               \
+\
+_sol_ \
+V V##_qslerp(V a, V b, T t) {                                       \
+  const T d = V##_sum(V##_mul(a, b));                               \
+  const T c = (d < 0) ? -d : d;                                     \
+  if (c > (T) 0.9995)                                               \
+    return V##_qnlerp(a, b, t);                                     \
+  const T s = T##_sqrt(1 - c * c);                                  \
+  const T th = T##_atan2(s, c);                                     \
+  const T wa = T##_sin_precise((1 - t) * th) / s;                   \
+  const T wb = T##_sin_precise(t * th) / s;                         \
+  return V##_fma(b, V##_setf((d < 0) ? -wb : wb), V##_mulf(a, wa)); \
+}                                                                   \
+\
+/* Matrix Conversion */ \
+\
+_sol_ \
+M3 V##_qmat3(V q) {                                                \
+  const V q2 = V##_add(q, q);                                      \
+  const T xx = x(q) * x(q2), yy = y(q) * y(q2), zz = z(q) * z(q2); \
+  const T xy = x(q) * y(q2), xz = x(q) * z(q2), yz = y(q) * z(q2); \
+  const T wx = w(q) * x(q2), wy = w(q) * y(q2), wz = w(q) * z(q2); \
+  const M3 out = {{                                                \
+    V3##_set(1 - (yy + zz), xy + wz, xz - wy),                     \
+    V3##_set(xy - wz, 1 - (xx + zz), yz + wx),                     \
+    V3##_set(xz + wy, yz - wx, 1 - (xx + yy))                      \
+  }};                                                              \
+  return out;                                                      \
+}                                                                  \
+\
+_sol_ \
+M V##_qmat(V q) {                                             \
+  const M3 r = V##_qmat3(q);                                  \
+  return M##_set(V##_set(x(r.c[0]), y(r.c[0]), z(r.c[0]), 0), \
+                 V##_set(x(r.c[1]), y(r.c[1]), z(r.c[1]), 0), \
+                 V##_set(x(r.c[2]), y(r.c[2]), z(r.c[2]), 0), \
+                 V##_set(0, 0, 0, 1));                        \
+}                                                             \
+\
+/* Bulk Math */ \
+\
+SOL_N2(V##_qmul, V, V) \
+SOL_N1(V##_qconj, V, V) \
+SOL_N1(V##_qinv, V, V) \
+FXQ_N2(V##_qrot, V3, V, V3) \
+FXQ_N2F(V##_qnlerp, V, V, T, t) \
+FXQ_N2F(V##_qslerp, V, V, T, t)
+
+FXQ(f32, f32x4, f32x3, f32x4x4, f32x3x3)
+FXQ(f64, f64x4, f64x3, f64x4x4, f64x3x3)
+
+#undef FXQ
+#undef FXQ_N2
+#undef FXQ_N2F
+
+#endif /* SOL_FXQ_H */
@@ -0,0 +1,206 @@
+/*
+** hx.h | The Sol Vector Library | Code for f16, f16x2, f16x3 and f16x4.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_HX_H
+#define SOL_HX_H
+
+/*
+** Convenience Macros
+**
+** With F16C, HX_ENC8 and HX_DEC8 convert eight values with one instruction
+** each way. Otherwise they fall back to HX_enc and HX_dec, which handle zero,
+** subnormals, infinity and NaN and round to nearest even without branching,
+** or under SOL_GNU to HX_enc4 and HX_dec4, which do the same four at a time.
+*/
+
+_sol_
+u16 HX_enc(f32 f) {
+  u32 u;
+  memcpy(&u, &f, sizeof u);
+  const u32 sign = (u >> 16) & 0x8000;
+  u &= 0x7fffffff;
+  /* Normal: rebias the exponent and round on the 13 dropped bits. */
+  const u32 norm = (u + 0xc8000fff + ((u >> 13) & 1)) >> 13;
+  /* Subnormal: let an f32 add align and round the mantissa. */
+  f32 t;
+  memcpy(&t, &u, sizeof t);
+  t += 0.5f;
+  u32 sub;
+  memcpy(&sub, &t, sizeof sub);
+  sub -= 0x3f000000;
+  const u32 big = (u > 0x7f800000) ? 0x7e00 : 0x7c00;
+  const u32 out = (u >= 0x47800000) ? big : (u < 0x38800000) ? sub : norm;
+  return (u16) (out | sign);
+}
+
+_sol_
+f32 HX_dec(u16 h) {
+  const u32 e = h & 0x7c00u;
+  u32 u = ((h & 0x7fffu) << 13) + 0x38000000;
+  u += (e == 0x7c00) ? 0x38000000 : 0;
+  u += (e == 0) ? 0x00800000 : 0;
+  f32 f;
+  memcpy(&f, &u, sizeof f);
+  f -= (e == 0) ? 6.103515625e-05f : 0;
+  memcpy(&u, &f, sizeof u);
+  u |= (u32) (h & 0x8000) << 16;
+  memcpy(&f, &u, sizeof f);
+  return f;
+}
+
+#if defined(SOL_GNU) && __has_builtin(__builtin_convertvector)
+  /*
+  ** The same steps on four lanes at once, with the selects done by masks.
+  */
+
+  _sol_
+  void HX_enc4(f16* dst, const f32* src) {
+    f32x4 f;
+    memcpy(&f, src, sizeof f);
+    u32x4 u = (u32x4) f;
+    const u32x4 sign = (u >> 16) & 0x8000;
+    u &= 0x7fffffff;
+    const u32x4 norm = (u + 0xc8000fff + ((u >> 13) & 1)) >> 13;
+    const u32x4 sub = (u32x4) ((f32x4) u + 0.5f) - 0x3f000000;
+    const u32x4 is_nan = (u32x4) (u > 0x7f800000);
+    const u32x4 is_big = (u32x4) (u >= 0x47800000);
+    const u32x4 is_small = (u32x4) (u < 0x38800000);
+    const u32x4 top = (0x7e00 & is_nan) | (0x7c00 & ~is_nan);
+    const u32x4 fin = (sub & is_small) | (norm & ~is_small);
+    const u32x4 bits = (top & is_big) | (fin & ~is_big) | sign;
+    const u16x4 out = __builtin_convertvector(bits, u16x4);
+    memcpy(dst, &out, sizeof out);
+  }
+
+  _sol_
+  void HX_dec4(f32* dst, const f16* src) {
+    u16x4 h;
+    memcpy(&h, src, sizeof h);
+    const u32x4 wide = __builtin_convertvector(h, u32x4);
+    const u32x4 e = wide & 0x7c00;
+    const u32x4 is_inf = (u32x4) (e == 0x7c00);
+    const u32x4 is_sub = (u32x4) (e == 0);
+    u32x4 u = ((wide & 0x7fff) << 13) + 0x38000000;
+    u += (is_inf & 0x38000000) + (is_sub & 0x00800000);
+    const f32x4 f = (f32x4) u - (f32x4) (is_sub & 0x38800000);
+    const u32x4 out = (u32x4) f | ((wide & 0x8000) << 16);
+    memcpy(dst, &out, sizeof out);
+  }
+#endif
+
+#ifdef __F16C__
+  #define HX_ENC(F) _cvtss_sh(F, 0)
+  #define HX_DEC(H) _cvtsh_ss(H)
+  #define HX_ENC8(D, F) \
+    _mm_storeu_si128((__m128i*) (D), _mm256_cvtps_ph(_mm256_loadu_ps(F), 0))
+  #define HX_DEC8(D, H) \
+    _mm256_storeu_ps(D, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*) (H))))
+#elif defined(SOL_GNU) && __has_builtin(__builtin_convertvector)
+  #define HX_ENC(F) HX_enc(F)
+  #define HX_DEC(H) HX_dec(H)
+  #define HX_ENC8(D, F) (HX_enc4(D, F), HX_enc4((D) + 4, (F) + 4))
+  #define HX_DEC8(D, H) (HX_dec4(D, H), HX_dec4((D) + 4, (H) + 4))
+#else
+  #define HX_ENC(F) HX_enc(F)
+  #define HX_DEC(H) HX_dec(H)
+  #define HX_ENC8(D, F)            \
+    for (size_t j = 0; j < 8; j++) \
+      (D)[j] = HX_enc((F)[j])
+  #define HX_DEC8(D, H)            \
+    for (size_t j = 0; j < 8; j++) \
+      (D)[j] = HX_dec((H)[j])
+#endif
+
+/*
+** Scalars
+*/
+
+_sol_
+f16 f32_to_f16(f32 f) {
+  return (f16) HX_ENC(f);
+}
+
+_sol_
+f32 f16_to_f32(f16 h) {
+  return HX_DEC(h);
+}
+
+SOL_KERNEL(f32_to_f16_n, (f16* dst, const f32* f, size_t n), (dst, f, n), {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    HX_ENC8(dst + i, f + i);
+  for (; i < n; i++)
+    dst[i] = f32_to_f16(f[i]);
+})
+
+SOL_PAR_N1(f32_to_f16, f16, f32)
+
+SOL_KERNEL(f16_to_f32_n, (f32* dst, const f16* h, size_t n), (dst, h, n), {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    HX_DEC8(dst + i, h + i);
+  for (; i < n; i++)
+    dst[i] = f16_to_f32(h[i]);
+})
+
+SOL_PAR_N1(f16_to_f32, f32, f16)
+
+/*
+** Definer Macros
+**
+** An array of `V`s with no padding is a flat array of f32s, and an array of
+** `H`s is always a flat array of f16s, so whole arrays go through the scalar
+** kernels. Only `f32x3` under SOL_GNU has to be done one element at a time.
+*/
+
+#define HX(W, V, H) \
+\
+_sol_ \
+H V##_to_f16(V v) {                      \
+  H out;                                 \
+  for (size_t i = 0; i < W; i++)         \
+    (&out.x)[i] = f32_to_f16(vec(v)[i]); \
+  return out;                            \
+}                                        \
+\
+_sol_ \
+V H##_to_f32(H h) {                      \
+  V out = {0};                           \
+  for (size_t i = 0; i < W; i++)         \
+    vec(out)[i] = f16_to_f32((&h.x)[i]); \
+  return out;                            \
+}                                        \
+\
+SOL_KERNEL(V##_to_f16_n, (H* dst, const V* v, size_t n), (dst, v, n), { \
+  if (sizeof(V) == W * sizeof(f32)) {             \
+    f32_to_f16_n(&dst->x, (const f32*) v, n * W); \
+    return;                                       \
+  }                                               \
+  for (size_t i = 0; i < n; i++)                  \
+    dst[i] = V##_to_f16(v[i]);                    \
+})                                                \
+SOL_PAR_N1(V##_to_f16, H, V)                      \
+\
+SOL_KERNEL(H##_to_f32_n, (V* dst, const H* h, size_t n), (dst, h, n), { \
+  if (sizeof(V) == W * sizeof(f32)) {       \
+    f16_to_f32_n((f32*) dst, &h->x, n * W); \
+    return;                                 \
+  }                                         \
+  for (size_t i = 0; i < n; i++)            \
+    dst[i] = H##_to_f32(h[i]);              \
+})                                          \
+SOL_PAR_N1(H##_to_f32, V, H)
+
+HX(2, f32x2, f16x2)
+HX(3, f32x3, f16x3)
+HX(4, f32x4, f16x4)
+
+#undef HX
+#undef HX_ENC
+#undef HX_DEC
+#undef HX_ENC8
+#undef HX_DEC8
+
+#endif /* SOL_HX_H */
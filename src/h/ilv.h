@@ -0,0 +1,281 @@
+/*
+** ilv.h | The Sol Vector Library | Interleaving and deinterleaving of arrays.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_ILV_H
+#define SOL_ILV_H
+
+/*
+** Convenience Macros
+**
+** Each kernel moves `W` tuples at a time through the 16-byte vector `V`, so
+** every load and store is a whole vector and only the lanes in between move.
+** ILV_J##W lists `F(j, W, K)` for every lane `j`, which gives ILV_SHUF its
+** constant indices; ILV_ANY marks a lane whose value does not matter.
+**
+** Two components are split by taking the even and odd lanes of a pair of
+** vectors, and joined by zipping their low and high halves. Four are two such
+** splits or joins in a row, the same unpacks as a 4x4 transpose. Three take two
+** shuffles per vector: the first gathers what it can from the first two
+** sources, the second fills in the rest from the third.
+*/
+
+#define ILV_J2(F, W, K) F(0, W, K), F(1, W, K)
+#define ILV_J4(F, W, K) ILV_J2(F, W, K), F(2, W, K), F(3, W, K)
+#define ILV_J8(F, W, K) \
+  ILV_J4(F, W, K), F(4, W, K), F(5, W, K), F(6, W, K), F(7, W, K)
+#define ILV_J16(F, W, K)                                             \
+  ILV_J8(F, W, K), F(8, W, K), F(9, W, K), F(10, W, K), F(11, W, K), \
+  F(12, W, K), F(13, W, K), F(14, W, K), F(15, W, K)
+
+#define ILV_ODD(J, W, K) (2 * (J) + (K))
+#define ILV_ZIP(J, W, K) ((J) % 2 * (W) + (K) * (W) / 2 + (J) / 2)
+
+#define ILV_D3A(J, W, K) (3 * (J) + (K) < 2 * (W) ? 3 * (J) + (K) : ILV_ANY)
+#define ILV_D3B(J, W, K) \
+  (3 * (J) + (K) < 2 * (W) ? (J) : 3 * (J) + (K) - (W))
+
+#define ILV_M(J, W, Q) ((Q) * (W) + (J))
+#define ILV_I3A(J, W, Q)                        \
+  (ILV_M(J, W, Q) % 3 == 0 ? ILV_M(J, W, Q) / 3 \
+   : ILV_M(J, W, Q) % 3 == 1 ? (W) + ILV_M(J, W, Q) / 3 : ILV_ANY)
+#define ILV_I3B(J, W, Q) \
+  (ILV_M(J, W, Q) % 3 == 2 ? (W) + ILV_M(J, W, Q) / 3 : (J))
+
+#if defined(SOL_GNU) && __has_builtin(__builtin_shufflevector)
+  #define ILV_ANY -1
+  #define ILV_SHUF(V, W, F, K, A, B) \
+    __builtin_shufflevector(A, B, ILV_J##W(F, W, K))
+#else
+  #define ILV_ANY 0
+  #define ILV_SHUF(V, W, F, K, A, B) V##_shuffle2(A, B, ILV_J##W(F, W, K))
+#endif
+#define ILV_SHUF2(V, W, F, G, K, A, B, C) \
+  ILV_SHUF(V, W, G, K, ILV_SHUF(V, W, F, K, A, B), C)
+
+/*
+** Plain SSE2 has no byte shuffle, so the 3-way byte kernels are slower than
+** the scalar loop there; ILV_VEC3 skips straight to it. SOL_DISPATCH builds
+** keep the vector loop, which their AVX variants compile to `pshufb`.
+*/
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(__SSSE3__) && \
+    !defined(SOL_DISPATCH)
+  #define ILV_VEC3(W) ((W) < 16)
+#else
+  #define ILV_VEC3(W) 1
+#endif
+
+#define ILV_LOAD(V, O, P) \
+  V O;                    \
+  memcpy(&O, P, sizeof O)
+
+#define ILV_STORE(V, P, X)     \
+  {                            \
+    const V t_ = X;            \
+    memcpy(P, &t_, sizeof t_); \
+  }
+
+/*
+** ILV_PAR adds `T_F_par_n`, which hands each slice `[lo, hi)` to `T_F_n` with
+** `CALL`; `O` and `I` are the output and input arrays, padded to four with
+** NULL. The interleaved side of the call steps by `K` elements per tuple.
+*/
+
+#define ILV_ARR(A, B, C, D) {A, B, C, D}
+
+#ifdef SOL_THREADS
+  #define ILV_PAR_CTX(T) \
+    typedef struct { T* o[4]; const T* i[4]; } T##_ilv_ctx;
+
+  #define ILV_PAR(T, F, P, O, I, CALL)                                      \
+    static inline void T##_##F##_par_run(void* ctx, size_t lo, size_t hi) { \
+      const T##_ilv_ctx* x = (const T##_ilv_ctx*) ctx;                      \
+      T##_##F##_n CALL;                                                     \
+    }                                                                       \
+    _sol_ void T##_##F##_par_n P {                                          \
+      T##_ilv_ctx job = {ILV_ARR O, ILV_ARR I};                             \
+      sol_par_for(n, T##_##F##_par_run, &job);                              \
+    }
+#else
+  #define ILV_PAR_CTX(T)
+  #define ILV_PAR(T, F, P, O, I, CALL)
+#endif
+
+/*
+** Definer Macros
+*/
+
+#define ILV(T, V, W) \
+\
+SOL_KERNEL(T##_deinterleave2_n, (T* x, T* y, const T* src, size_t n), (x, y, src, n), { \
+  size_t i = 0;                                            \
+  for (; i + W <= n; i += W) {                             \
+    ILV_LOAD(V, a, src + 2 * i);                           \
+    ILV_LOAD(V, b, src + 2 * i + W);                       \
+    ILV_STORE(V, x + i, ILV_SHUF(V, W, ILV_ODD, 0, a, b)); \
+    ILV_STORE(V, y + i, ILV_SHUF(V, W, ILV_ODD, 1, a, b)); \
+  }                                                        \
+  for (; i < n; i++) {                                     \
+    x[i] = src[2 * i];                                     \
+    y[i] = src[2 * i + 1];                                 \
+  }                                                        \
+})                                                         \
+\
+SOL_KERNEL(T##_deinterleave3_n, (T* x, T* y, T* z, const T* src, size_t n), (x, y, z, src, n), { \
+  size_t i = 0;                                                         \
+  for (; ILV_VEC3(W) && i + W <= n; i += W) {                           \
+    ILV_LOAD(V, a, src + 3 * i);                                        \
+    ILV_LOAD(V, b, src + 3 * i + W);                                    \
+    ILV_LOAD(V, c, src + 3 * i + 2 * W);                                \
+    ILV_STORE(V, x + i, ILV_SHUF2(V, W, ILV_D3A, ILV_D3B, 0, a, b, c)); \
+    ILV_STORE(V, y + i, ILV_SHUF2(V, W, ILV_D3A, ILV_D3B, 1, a, b, c)); \
+    ILV_STORE(V, z + i, ILV_SHUF2(V, W, ILV_D3A, ILV_D3B, 2, a, b, c)); \
+  }                                                                     \
+  for (; i < n; i++) {                                                  \
+    x[i] = src[3 * i];                                                  \
+    y[i] = src[3 * i + 1];                                              \
+    z[i] = src[3 * i + 2];                                              \
+  }                                                                     \
+})                                                                      \
+\
+SOL_KERNEL(T##_deinterleave4_n, (T* x, T* y, T* z, T* w, const T* src, size_t n), (x, y, z, w, src, n), { \
+  size_t i = 0;                                              \
+  for (; i + W <= n; i += W) {                               \
+    ILV_LOAD(V, a, src + 4 * i);                             \
+    ILV_LOAD(V, b, src + 4 * i + W);                         \
+    ILV_LOAD(V, c, src + 4 * i + 2 * W);                     \
+    ILV_LOAD(V, d, src + 4 * i + 3 * W);                     \
+    const V e0 = ILV_SHUF(V, W, ILV_ODD, 0, a, b);           \
+    const V o0 = ILV_SHUF(V, W, ILV_ODD, 1, a, b);           \
+    const V e1 = ILV_SHUF(V, W, ILV_ODD, 0, c, d);           \
+    const V o1 = ILV_SHUF(V, W, ILV_ODD, 1, c, d);           \
+    ILV_STORE(V, x + i, ILV_SHUF(V, W, ILV_ODD, 0, e0, e1)); \
+    ILV_STORE(V, y + i, ILV_SHUF(V, W, ILV_ODD, 0, o0, o1)); \
+    ILV_STORE(V, z + i, ILV_SHUF(V, W, ILV_ODD, 1, e0, e1)); \
+    ILV_STORE(V, w + i, ILV_SHUF(V, W, ILV_ODD, 1, o0, o1)); \
+  }                                                          \
+  for (; i < n; i++) {                                       \
+    x[i] = src[4 * i];                                       \
+    y[i] = src[4 * i + 1];                                   \
+    z[i] = src[4 * i + 2];                                   \
+    w[i] = src[4 * i + 3];                                   \
+  }                                                          \
+})                                                           \
+\
+SOL_KERNEL(T##_interleave2_n, (T* dst, const T* x, const T* y, size_t n), (dst, x, y, n), { \
+  size_t i = 0;                                                      \
+  for (; i + W <= n; i += W) {                                       \
+    ILV_LOAD(V, a, x + i);                                           \
+    ILV_LOAD(V, b, y + i);                                           \
+    ILV_STORE(V, dst + 2 * i, ILV_SHUF(V, W, ILV_ZIP, 0, a, b));     \
+    ILV_STORE(V, dst + 2 * i + W, ILV_SHUF(V, W, ILV_ZIP, 1, a, b)); \
+  }                                                                  \
+  for (; i < n; i++) {                                               \
+    dst[2 * i] = x[i];                                               \
+    dst[2 * i + 1] = y[i];                                           \
+  }                                                                  \
+})                                                                   \
+\
+SOL_KERNEL(T##_interleave3_n, (T* dst, const T* x, const T* y, const T* z, size_t n), (dst, x, y, z, n), { \
+  size_t i = 0;                                                                       \
+  for (; ILV_VEC3(W) && i + W <= n; i += W) {                                         \
+    ILV_LOAD(V, a, x + i);                                                            \
+    ILV_LOAD(V, b, y + i);                                                            \
+    ILV_LOAD(V, c, z + i);                                                            \
+    ILV_STORE(V, dst + 3 * i, ILV_SHUF2(V, W, ILV_I3A, ILV_I3B, 0, a, b, c));         \
+    ILV_STORE(V, dst + 3 * i + W, ILV_SHUF2(V, W, ILV_I3A, ILV_I3B, 1, a, b, c));     \
+    ILV_STORE(V, dst + 3 * i + 2 * W, ILV_SHUF2(V, W, ILV_I3A, ILV_I3B, 2, a, b, c)); \
+  }                                                                                   \
+  for (; i < n; i++) {                                                                \
+    dst[3 * i] = x[i];                                                                \
+    dst[3 * i + 1] = y[i];                                                            \
+    dst[3 * i + 2] = z[i];                                                            \
+  }                                                                                   \
+})                                                                                    \
+\
+SOL_KERNEL(T##_interleave4_n, (T* dst, const T* x, const T* y, const T* z, const T* w, size_t n), (dst, x, y, z, w, n), { \
+  size_t i = 0;                                                            \
+  for (; i + W <= n; i += W) {                                             \
+    ILV_LOAD(V, a, x + i);                                                 \
+    ILV_LOAD(V, b, y + i);                                                 \
+    ILV_LOAD(V, c, z + i);                                                 \
+    ILV_LOAD(V, d, w + i);                                                 \
+    const V e0 = ILV_SHUF(V, W, ILV_ZIP, 0, a, c);                         \
+    const V e1 = ILV_SHUF(V, W, ILV_ZIP, 1, a, c);                         \
+    const V o0 = ILV_SHUF(V, W, ILV_ZIP, 0, b, d);                         \
+    const V o1 = ILV_SHUF(V, W, ILV_ZIP, 1, b, d);                         \
+    ILV_STORE(V, dst + 4 * i, ILV_SHUF(V, W, ILV_ZIP, 0, e0, o0));         \
+    ILV_STORE(V, dst + 4 * i + W, ILV_SHUF(V, W, ILV_ZIP, 1, e0, o0));     \
+    ILV_STORE(V, dst + 4 * i + 2 * W, ILV_SHUF(V, W, ILV_ZIP, 0, e1, o1)); \
+    ILV_STORE(V, dst + 4 * i + 3 * W, ILV_SHUF(V, W, ILV_ZIP, 1, e1, o1)); \
+  }                                                                        \
+  for (; i < n; i++) {                                                     \
+    dst[4 * i] = x[i];                                                     \
+    dst[4 * i + 1] = y[i];                                                 \
+    dst[4 * i + 2] = z[i];                                                 \
+    dst[4 * i + 3] = w[i];                                                 \
+  }                                                                        \
+})                                                                         \
+\
+ILV_PAR_CTX(T) \
+ILV_PAR(T, deinterleave2, (T* x, T* y, const T* src, size_t n), \
+        (x, y, NULL, NULL), (src, NULL, NULL, NULL), \
+        (x->o[0] + lo, x->o[1] + lo, x->i[0] + 2 * lo, hi - lo)) \
+ILV_PAR(T, deinterleave3, (T* x, T* y, T* z, const T* src, size_t n), \
+        (x, y, z, NULL), (src, NULL, NULL, NULL), \
+        (x->o[0] + lo, x->o[1] + lo, x->o[2] + lo, x->i[0] + 3 * lo, \
+         hi - lo)) \
+ILV_PAR(T, deinterleave4, (T* x, T* y, T* z, T* w, const T* src, size_t n), \
+        (x, y, z, w), (src, NULL, NULL, NULL), \
+        (x->o[0] + lo, x->o[1] + lo, x->o[2] + lo, x->o[3] + lo, \
+         x->i[0] + 4 * lo, hi - lo)) \
+ILV_PAR(T, interleave2, (T* dst, const T* x, const T* y, size_t n), \
+        (dst, NULL, NULL, NULL), (x, y, NULL, NULL), \
+        (x->o[0] + 2 * lo, x->i[0] + lo, x->i[1] + lo, hi - lo)) \
+ILV_PAR(T, interleave3, (T* dst, const T* x, const T* y, const T* z, \
+                         size_t n), \
+        (dst, NULL, NULL, NULL), (x, y, z, NULL), \
+        (x->o[0] + 3 * lo, x->i[0] + lo, x->i[1] + lo, x->i[2] + lo, \
+         hi - lo)) \
+ILV_PAR(T, interleave4, (T* dst, const T* x, const T* y, const T* z, \
+                         const T* w, size_t n), \
+        (dst, NULL, NULL, NULL), (x, y, z, w), \
+        (x->o[0] + 4 * lo, x->i[0] + lo, x->i[1] + lo, x->i[2] + lo, \
+         x->i[3] + lo, hi - lo))
+
+ILV(f32, f32x4, 4)
+ILV(f64, f64x2, 2)
+ILV(i8, i8x16, 16)
+ILV(i16, i16x8, 8)
+ILV(i32, i32x4, 4)
+ILV(i64, i64x2, 2)
+ILV(u8, u8x16, 16)
+ILV(u16, u16x8, 8)
+ILV(u32, u32x4, 4)
+ILV(u64, u64x2, 2)
+
+#undef ILV
+#undef ILV_J2
+#undef ILV_J4
+#undef ILV_J8
+#undef ILV_J16
+#undef ILV_ODD
+#undef ILV_ZIP
+#undef ILV_D3A
+#undef ILV_D3B
+#undef ILV_M
+#undef ILV_VEC3
+#undef ILV_ANY
+#undef ILV_I3A
+#undef ILV_I3B
+#undef ILV_SHUF
+#undef ILV_SHUF2
+#undef ILV_LOAD
+#undef ILV_STORE
+#undef ILV_ARR
+#undef ILV_PAR_CTX
+#undef ILV_PAR
+
+#endif /* SOL_ILV_H */
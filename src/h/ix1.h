@@ -1,9 +1,46 @@
 /*
-** ix1.h | The Sol Vector Library | Code for i32 and i64.
+** ix1.h | The Sol Vector Library | Code for i8 to i64.
 ** https://github.com/davidgarland/sol
 */
 
 #ifndef SOL_IX1_H
 #define SOL_IX1_H
 
+/*
+** Definer Macros
+**
+** `W` is a signed type twice as wide as `T`, so the full product fits.
+*/
+
+#define IX1(T, W) \
+\
+_sol_ \
+T T##_mulhi(T a, T b) {                        \
+  return (T) (((W) a * b) >> (8 * sizeof(T))); \
+}
+
+IX1(i8,  i16)
+IX1(i16, i32)
+IX1(i32, i64)
+
+#undef IX1
+
+/*
+** Without `__int128`, the signed high half is the unsigned one from four
+** 32-bit partial products, less `b` if `a` is negative and `a` if `b` is.
+*/
+
+_sol_
+i64 i64_mulhi(i64 a, i64 b) {
+  #ifdef __SIZEOF_INT128__
+    return (i64) __extension__ (((__int128) a * b) >> 64);
+  #else
+    const u64 a0 = (u64) a & 0xffffffff, a1 = (u64) a >> 32;
+    const u64 b0 = (u64) b & 0xffffffff, b1 = (u64) b >> 32;
+    const u64 mid = ((a0 * b0) >> 32) + ((a1 * b0) & 0xffffffff) + a0 * b1;
+    const u64 hi = a1 * b1 + ((a1 * b0) >> 32) + (mid >> 32);
+    return (i64) (hi - ((a < 0) ? (u64) b : 0) - ((b < 0) ? (u64) a : 0));
+  #endif
+}
+
 #endif /* SOL_IX1_H */
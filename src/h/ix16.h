@@ -0,0 +1,192 @@
+/*
+** ix16.h | The Sol Vector Library | Code for i8x16 to i64x16.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_IX16_H
+#define SOL_IX16_H
+
+#ifdef SOL_GNU
+  #define IX16_OP(O, A, OP, B) O = A OP B
+  #define IX16_OPF(O, V, OP, F) O = V OP F
+  #define IX16_FOP(O, F, OP, V) O = F OP V
+  #define IX16_OP2(O, A, AB, B, BC, C) O = (A AB B) BC C
+#else
+  #define IX16_OP(O, A, OP, B) \
+    for (size_t i = 0; i < 16; i++) vec(O)[i] = vec(A)[i] OP vec(B)[i]
+  #define IX16_OPF(O, V, OP, F) \
+    for (size_t i = 0; i < 16; i++) vec(O)[i] = vec(V)[i] OP F
+  #define IX16_FOP(O, F, OP, V) \
+    for (size_t i = 0; i < 16; i++) vec(O)[i] = F OP vec(V)[i]
+  #define IX16_OP2(O, A, AB, B, BC, C) \
+    for (size_t i = 0; i < 16; i++) vec(O)[i] = (vec(A)[i] AB vec(B)[i]) BC vec(C)[i]
+#endif
+
+#define IX16(T, V) \
+\
+/* Initializers */ \
+\
+_sol_ \
+V V##_set(T l0, T l1, T l2, T l3, T l4, T l5, T l6, T l7,         \
+          T l8, T l9, T l10, T l11, T l12, T l13, T l14, T l15) { \
+  const T l[16] = {l0, l1, l2, l3, l4, l5, l6, l7,                \
+                   l8, l9, l10, l11, l12, l13, l14, l15};         \
+  V out;                                                          \
+  memcpy(&out, l, sizeof out);                                    \
+  return out;                                                     \
+}                                                                 \
+\
+_sol_ \
+V V##_setf(T f) {                 \
+  V out;                          \
+  for (size_t i = 0; i < 16; i++) \
+    vec(out)[i] = f;              \
+  return out;                     \
+}                                 \
+\
+_sol_ \
+V V##_zero(void) {        \
+  return V##_setf((T) 0); \
+}                         \
+\
+_sol_ \
+V V##_load(const T* p) {       \
+  V out;                       \
+  memcpy(&out, p, sizeof out); \
+  return out;                  \
+}                              \
+\
+_sol_ \
+void V##_store(T* p, V v) { \
+  memcpy(p, &v, sizeof v);  \
+}                           \
+\
+/* Basic Math */ \
+\
+_sol_ \
+T V##_sum(V v) {                  \
+  T out = 0;                      \
+  for (size_t i = 0; i < 16; i++) \
+    out += vec(v)[i];             \
+  return out;                     \
+}                                 \
+\
+_sol_ \
+V V##_sq(V v) {         \
+  return V##_mul(v, v); \
+}                       \
+\
+_sol_ \
+V V##_add(V a, V b) {    \
+  V out;                 \
+  IX16_OP(out, a, +, b); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_addf(V v, T f) {    \
+  V out;                  \
+  IX16_OPF(out, v, +, f); \
+  return out;             \
+}                         \
+\
+_sol_ \
+V V##_sub(V a, V b) {    \
+  V out;                 \
+  IX16_OP(out, a, -, b); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_subf(V v, T f) {    \
+  V out;                  \
+  IX16_OPF(out, v, -, f); \
+  return out;             \
+}                         \
+\
+_sol_ \
+V V##_fsub(T f, V v) {    \
+  V out;                  \
+  IX16_FOP(out, f, -, v); \
+  return out;             \
+}                         \
+\
+_sol_ \
+V V##_mul(V a, V b) {    \
+  MUL_##T(V, a, b)       \
+  V out;                 \
+  IX16_OP(out, a, *, b); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_mulf(V v, T f) {    \
+  V out;                  \
+  IX16_OPF(out, v, *, f); \
+  return out;             \
+}                         \
+\
+_sol_ \
+V V##_div(V a, V b) {    \
+  V out;                 \
+  IX16_OP(out, a, /, b); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_divf(V v, T f) {    \
+  V out;                  \
+  IX16_OPF(out, v, /, f); \
+  return out;             \
+}                         \
+\
+_sol_ \
+V V##_fdiv(T f, V v) {    \
+  V out;                  \
+  IX16_FOP(out, f, /, v); \
+  return out;             \
+}                         \
+\
+_sol_ \
+V V##_fma(V a, V b, V c) {      \
+  V out;                        \
+  IX16_OP2(out, a, *, b, +, c); \
+  return out;                   \
+}                               \
+\
+_sol_ \
+V V##_fms(V a, V b, V c) {      \
+  V out;                        \
+  IX16_OP2(out, a, *, b, -, c); \
+  return out;                   \
+}                               \
+\
+/* Bulk Kernels */ \
+\
+SOL_N1(V##_sum, T, V) \
+SOL_N1(V##_sq, V, V) \
+SOL_N2(V##_add, V, V) \
+SOL_N2F(V##_addf, V, V, T, f) \
+SOL_N2(V##_sub, V, V) \
+SOL_N2F(V##_subf, V, V, T, f) \
+SOL_NF2(V##_fsub, V, T, V) \
+SOL_N2(V##_mul, V, V) \
+SOL_N2F(V##_mulf, V, V, T, f) \
+SOL_N2(V##_div, V, V) \
+SOL_N2F(V##_divf, V, V, T, f) \
+SOL_NF2(V##_fdiv, V, T, V) \
+SOL_N3(V##_fma, V, V) \
+SOL_N3(V##_fms, V, V)
+
+IX16(i8,   i8x16)
+IX16(i16, i16x16)
+IX16(i32, i32x16)
+IX16(i64, i64x16)
+
+#undef IX16
+#undef IX16_OP
+#undef IX16_OPF
+#undef IX16_FOP
+#undef IX16_OP2
+
+#endif /* SOL_IX16_H */
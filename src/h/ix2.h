@@ -82,6 +82,7 @@ V V##_fsub(T f, V v) {            \
 \
 _sol_ \
 V V##_mul(V a, V b) {            \
+  MUL_##T(V, a, b)               \
   const V out = IX2_OP(a, *, b); \
   return out;                    \
 }                                \
@@ -121,6 +122,23 @@ V V##_fms(V a, V b, V c) {              \
   const V out = IX2_OP2(a, *, b, -, c); \
   return out;                           \
 }                                       \
+\
+/* Bulk Kernels */ \
+\
+SOL_N1(V##_sum, T, V) \
+SOL_N1(V##_sq, V, V) \
+SOL_N2(V##_add, V, V) \
+SOL_N2F(V##_addf, V, V, T, f) \
+SOL_N2(V##_sub, V, V) \
+SOL_N2F(V##_subf, V, V, T, f) \
+SOL_NF2(V##_fsub, V, T, V) \
+SOL_N2(V##_mul, V, V) \
+SOL_N2F(V##_mulf, V, V, T, f) \
+SOL_N2(V##_div, V, V) \
+SOL_N2F(V##_divf, V, V, T, f) \
+SOL_NF2(V##_fdiv, V, T, V) \
+SOL_N3(V##_fma, V, V) \
+SOL_N3(V##_fms, V, V)
 
 IX2(i8,   i8x2)
 IX2(i16, i16x2)
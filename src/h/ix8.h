@@ -0,0 +1,190 @@
+/*
+** ix8.h | The Sol Vector Library | Code for i8x8 to i64x8.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_IX8_H
+#define SOL_IX8_H
+
+#ifdef SOL_GNU
+  #define IX8_OP(O, A, OP, B) O = A OP B
+  #define IX8_OPF(O, V, OP, F) O = V OP F
+  #define IX8_FOP(O, F, OP, V) O = F OP V
+  #define IX8_OP2(O, A, AB, B, BC, C) O = (A AB B) BC C
+#else
+  #define IX8_OP(O, A, OP, B) \
+    for (size_t i = 0; i < 8; i++) vec(O)[i] = vec(A)[i] OP vec(B)[i]
+  #define IX8_OPF(O, V, OP, F) \
+    for (size_t i = 0; i < 8; i++) vec(O)[i] = vec(V)[i] OP F
+  #define IX8_FOP(O, F, OP, V) \
+    for (size_t i = 0; i < 8; i++) vec(O)[i] = F OP vec(V)[i]
+  #define IX8_OP2(O, A, AB, B, BC, C) \
+    for (size_t i = 0; i < 8; i++) vec(O)[i] = (vec(A)[i] AB vec(B)[i]) BC vec(C)[i]
+#endif
+
+#define IX8(T, V) \
+\
+/* Initializers */ \
+\
+_sol_ \
+V V##_set(T l0, T l1, T l2, T l3, T l4, T l5, T l6, T l7) { \
+  const T l[8] = {l0, l1, l2, l3, l4, l5, l6, l7};          \
+  V out;                                                    \
+  memcpy(&out, l, sizeof out);                              \
+  return out;                                               \
+}                                                           \
+\
+_sol_ \
+V V##_setf(T f) {                \
+  V out;                         \
+  for (size_t i = 0; i < 8; i++) \
+    vec(out)[i] = f;             \
+  return out;                    \
+}                                \
+\
+_sol_ \
+V V##_zero(void) {        \
+  return V##_setf((T) 0); \
+}                         \
+\
+_sol_ \
+V V##_load(const T* p) {       \
+  V out;                       \
+  memcpy(&out, p, sizeof out); \
+  return out;                  \
+}                              \
+\
+_sol_ \
+void V##_store(T* p, V v) { \
+  memcpy(p, &v, sizeof v);  \
+}                           \
+\
+/* Basic Math */ \
+\
+_sol_ \
+T V##_sum(V v) {                 \
+  T out = 0;                     \
+  for (size_t i = 0; i < 8; i++) \
+    out += vec(v)[i];            \
+  return out;                    \
+}                                \
+\
+_sol_ \
+V V##_sq(V v) {         \
+  return V##_mul(v, v); \
+}                       \
+\
+_sol_ \
+V V##_add(V a, V b) {   \
+  V out;                \
+  IX8_OP(out, a, +, b); \
+  return out;           \
+}                       \
+\
+_sol_ \
+V V##_addf(V v, T f) {   \
+  V out;                 \
+  IX8_OPF(out, v, +, f); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_sub(V a, V b) {   \
+  V out;                \
+  IX8_OP(out, a, -, b); \
+  return out;           \
+}                       \
+\
+_sol_ \
+V V##_subf(V v, T f) {   \
+  V out;                 \
+  IX8_OPF(out, v, -, f); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_fsub(T f, V v) {   \
+  V out;                 \
+  IX8_FOP(out, f, -, v); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_mul(V a, V b) {   \
+  MUL_##T(V, a, b)      \
+  V out;                \
+  IX8_OP(out, a, *, b); \
+  return out;           \
+}                       \
+\
+_sol_ \
+V V##_mulf(V v, T f) {   \
+  V out;                 \
+  IX8_OPF(out, v, *, f); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_div(V a, V b) {   \
+  V out;                \
+  IX8_OP(out, a, /, b); \
+  return out;           \
+}                       \
+\
+_sol_ \
+V V##_divf(V v, T f) {   \
+  V out;                 \
+  IX8_OPF(out, v, /, f); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_fdiv(T f, V v) {   \
+  V out;                 \
+  IX8_FOP(out, f, /, v); \
+  return out;            \
+}                        \
+\
+_sol_ \
+V V##_fma(V a, V b, V c) {     \
+  V out;                       \
+  IX8_OP2(out, a, *, b, +, c); \
+  return out;                  \
+}                              \
+\
+_sol_ \
+V V##_fms(V a, V b, V c) {     \
+  V out;                       \
+  IX8_OP2(out, a, *, b, -, c); \
+  return out;                  \
+}                              \
+\
+/* Bulk Kernels */ \
+\
+SOL_N1(V##_sum, T, V) \
+SOL_N1(V##_sq, V, V) \
+SOL_N2(V##_add, V, V) \
+SOL_N2F(V##_addf, V, V, T, f) \
+SOL_N2(V##_sub, V, V) \
+SOL_N2F(V##_subf, V, V, T, f) \
+SOL_NF2(V##_fsub, V, T, V) \
+SOL_N2(V##_mul, V, V) \
+SOL_N2F(V##_mulf, V, V, T, f) \
+SOL_N2(V##_div, V, V) \
+SOL_N2F(V##_divf, V, V, T, f) \
+SOL_NF2(V##_fdiv, V, T, V) \
+SOL_N3(V##_fma, V, V) \
+SOL_N3(V##_fms, V, V)
+
+IX8(i8,   i8x8)
+IX8(i16, i16x8)
+IX8(i32, i32x8)
+IX8(i64, i64x8)
+
+#undef IX8
+#undef IX8_OP
+#undef IX8_OPF
+#undef IX8_FOP
+#undef IX8_OP2
+
+#endif /* SOL_IX8_H */
@@ -0,0 +1,196 @@
+/*
+** par.h | The Sol Vector Library | Code for the SOL_THREADS thread pool.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_PAR_H
+#define SOL_PAR_H
+
+/*
+** Pool State
+**
+** The pool is started on first use and kept in statics, so like the dispatch
+** level each translation unit has its own, whose threads are never joined.
+** `want`, `stale` and `chunk` are read and written atomically, since the knobs
+** can be called at any time without taking `busy`. A job is `n` elements cut
+** into chunks; worker `t` owns a contiguous range of chunks `[next[t], end[t])`
+** and takes them from the front with an atomic add, then steals from the
+** other ranges the same way once its own is empty. The calling thread is
+** worker 0. Jobs are run one at a time: a call made while another is running,
+** including one from inside a job, just runs on the calling thread.
+**
+** `sol_threads_set` only stores the new size and marks the pool `stale`; the
+** next job to take `busy` stops the old threads and starts the new ones. So
+** it never waits on a running job, and is safe to call from inside one.
+*/
+
+typedef struct {
+  size_t next, end;
+  char pad[64 - 2 * sizeof(size_t)];
+} sol_par_range;
+
+static struct {
+  pthread_t th[SOL_THREADS_MAX];
+  pthread_mutex_t mu, busy;
+  pthread_cond_t go, done;
+  int want, live;
+  unsigned gen;
+  int pending;
+  bool quit, stale;
+  size_t chunk, len, size;
+  void (*f)(void* ctx, size_t lo, size_t hi);
+  void* ctx;
+  sol_par_range r[SOL_THREADS_MAX];
+} sol_pool = {
+  .mu = PTHREAD_MUTEX_INITIALIZER,
+  .busy = PTHREAD_MUTEX_INITIALIZER,
+  .go = PTHREAD_COND_INITIALIZER,
+  .done = PTHREAD_COND_INITIALIZER
+};
+
+_sol_
+void PAR_share(int t) {
+  const int n = sol_pool.live;
+  for (int k = 0; k < n; k++) {
+    sol_par_range* r = &sol_pool.r[(t + k) % n];
+    size_t c;
+    while ((c = __atomic_fetch_add(&r->next, 1, __ATOMIC_RELAXED)) < r->end) {
+      const size_t lo = c * sol_pool.size;
+      const size_t hi = (lo + sol_pool.size < sol_pool.len) ? lo + sol_pool.size : sol_pool.len;
+      sol_pool.f(sol_pool.ctx, lo, hi);
+    }
+  }
+}
+
+static void* PAR_worker(void* arg) {
+  const int t = (int) (intptr_t) arg;
+  unsigned seen = 0;
+  pthread_mutex_lock(&sol_pool.mu);
+  for (;;) {
+    while (sol_pool.gen == seen && !sol_pool.quit)
+      pthread_cond_wait(&sol_pool.go, &sol_pool.mu);
+    if (sol_pool.quit)
+      break;
+    seen = sol_pool.gen;
+    pthread_mutex_unlock(&sol_pool.mu);
+    PAR_share(t);
+    pthread_mutex_lock(&sol_pool.mu);
+    if (--sol_pool.pending == 0)
+      pthread_cond_signal(&sol_pool.done);
+  }
+  pthread_mutex_unlock(&sol_pool.mu);
+  return NULL;
+}
+
+_sol_
+void PAR_stop(void) {
+  pthread_mutex_lock(&sol_pool.mu);
+  sol_pool.quit = true;
+  pthread_cond_broadcast(&sol_pool.go);
+  pthread_mutex_unlock(&sol_pool.mu);
+  for (int t = 1; t < sol_pool.live; t++)
+    pthread_join(sol_pool.th[t], NULL);
+  sol_pool.quit = false;
+  sol_pool.live = 1;
+}
+
+_sol_
+void PAR_start(void) {
+  const int n = sol_threads_get();
+  sol_pool.gen = 0;
+  sol_pool.live = 1;
+  for (int t = 1; t < n; t++) {
+    if (pthread_create(&sol_pool.th[t], NULL, PAR_worker, (void*) (intptr_t) t))
+      break;
+    sol_pool.live = t + 1;
+  }
+}
+
+/*
+** Knobs
+*/
+
+_sol_
+int sol_threads_get(void) {
+  int want = __atomic_load_n(&sol_pool.want, __ATOMIC_RELAXED);
+  if (want <= 0) {
+    const long c = sysconf(_SC_NPROCESSORS_ONLN);
+    want = (c < 1) ? 1 : (c > SOL_THREADS_MAX) ? SOL_THREADS_MAX : (int) c;
+    __atomic_store_n(&sol_pool.want, want, __ATOMIC_RELAXED);
+  }
+  return want;
+}
+
+_sol_
+int sol_threads_set(int n) {
+  const int want = (n > SOL_THREADS_MAX) ? SOL_THREADS_MAX : n;
+  __atomic_store_n(&sol_pool.want, want, __ATOMIC_RELAXED);
+  __atomic_store_n(&sol_pool.stale, true, __ATOMIC_RELAXED);
+  return sol_threads_get();
+}
+
+_sol_
+size_t sol_chunk_get(size_t n) {
+  const size_t chunk = __atomic_load_n(&sol_pool.chunk, __ATOMIC_RELAXED);
+  if (chunk)
+    return chunk;
+  const size_t c = n / ((size_t) sol_threads_get() * 8);
+  return (c < 4096) ? 4096 : c;
+}
+
+_sol_
+void sol_chunk_set(size_t chunk) {
+  __atomic_store_n(&sol_pool.chunk, chunk, __ATOMIC_RELAXED);
+}
+
+/*
+** Parallel For
+**
+** PAR_for takes the chunk size from its caller, so one that sized a buffer by
+** it (like the parallel reductions) gets exactly those chunks even if
+** `sol_chunk_set` runs in between.
+*/
+
+_sol_
+void PAR_for(size_t n, size_t size, void (*f)(void* ctx, size_t lo, size_t hi), void* ctx) {
+  if (n <= size || pthread_mutex_trylock(&sol_pool.busy)) {
+    for (size_t lo = 0; lo < n; lo += size)
+      f(ctx, lo, (lo + size < n) ? lo + size : n);
+    return;
+  }
+  if (__atomic_exchange_n(&sol_pool.stale, false, __ATOMIC_RELAXED)) {
+    if (sol_pool.live > 1)
+      PAR_stop();
+    sol_pool.live = 0;
+  }
+  if (sol_pool.live == 0)
+    PAR_start();
+  const size_t chunks = (n + size - 1) / size;
+  const int t = sol_pool.live;
+  for (int k = 0; k < t; k++) {
+    sol_pool.r[k].next = chunks * (size_t) k / (size_t) t;
+    sol_pool.r[k].end = chunks * (size_t) (k + 1) / (size_t) t;
+  }
+  sol_pool.f = f;
+  sol_pool.ctx = ctx;
+  sol_pool.len = n;
+  sol_pool.size = size;
+  pthread_mutex_lock(&sol_pool.mu);
+  sol_pool.pending = t - 1;
+  sol_pool.gen++;
+  pthread_cond_broadcast(&sol_pool.go);
+  pthread_mutex_unlock(&sol_pool.mu);
+  PAR_share(0);
+  pthread_mutex_lock(&sol_pool.mu);
+  while (sol_pool.pending > 0)
+    pthread_cond_wait(&sol_pool.done, &sol_pool.mu);
+  pthread_mutex_unlock(&sol_pool.mu);
+  pthread_mutex_unlock(&sol_pool.busy);
+}
+
+_sol_
+void sol_par_for(size_t n, void (*f)(void* ctx, size_t lo, size_t hi), void* ctx) {
+  PAR_for(n, sol_chunk_get(n), f, ctx);
+}
+
+#endif /* SOL_PAR_H */
@@ -0,0 +1,144 @@
+/*
+** poly.h | The Sol Vector Library | Code for polynomial evaluation.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_POLY_H
+#define SOL_POLY_H
+
+/*
+** Convenience Macros
+**
+** `c` holds `degree + 1` coefficients, lowest power first, and each result is
+** `c[0] + c[1] x + ... + c[degree] x^degree` by Horner's rule: one `_fma` per
+** coefficient, so it rounds once per step where SOL_FMA allows. Each Horner
+** step waits on the one before it, so the `_n` forms run four independent
+** chains at once and fetch each coefficient once for all four. POLY_STEP
+** takes all four one step, on the inputs `x0` to `x3`.
+*/
+
+#define POLY_STEP(V, K)          \
+  {                              \
+    const V k_ = V##_setf(c[K]); \
+    r0 = V##_fma(r0, x0, k_);    \
+    r1 = V##_fma(r1, x1, k_);    \
+    r2 = V##_fma(r2, x2, k_);    \
+    r3 = V##_fma(r3, x3, k_);    \
+  }
+
+#define POLY_START(V)                 \
+  const V top_ = V##_setf(c[degree]); \
+  V r0 = top_, r1 = top_, r2 = top_, r3 = top_
+
+/*
+** POLY_PAR is SOL_PAR_N1 for the `_n` forms, passing `c` and `degree` to
+** every slice.
+*/
+
+#ifdef SOL_THREADS
+  #define POLY_PAR(F, R, T)                                                 \
+    typedef struct {                                                        \
+      R* dst; const R* v; const T* c; size_t degree;                        \
+    } F##_par_ctx;                                                          \
+    static inline void F##_par_run(void* ctx, size_t lo, size_t hi) {       \
+      const F##_par_ctx* x = (const F##_par_ctx*) ctx;                      \
+      F##_n(x->dst + lo, x->v + lo, x->c, x->degree, hi - lo);              \
+    }                                                                       \
+    _sol_ void F##_par_n(R* dst, const R* v, const T* c, size_t degree,     \
+                         size_t n) {                                        \
+      F##_par_ctx x = {dst, v, c, degree};                                  \
+      sol_par_for(n, F##_par_run, &x);                                      \
+    }
+#else
+  #define POLY_PAR(F, R, T)
+#endif
+
+/*
+** Definer Macros
+*/
+
+#define POLY(T, V) \
+\
+_sol_ \
+V V##_poly(V x, const T* c, size_t degree) { \
+  V r = V##_setf(c[degree]);                 \
+  for (size_t k = degree; k-- > 0;)          \
+    r = V##_fma(r, x, V##_setf(c[k]));       \
+  return r;                                  \
+}                                            \
+\
+SOL_KERNEL(V##_poly_n, (V* dst, const V* x, const T* c, size_t degree, size_t n), (dst, x, c, degree, n), { \
+  size_t i = 0;                           \
+  for (; i + 4 <= n; i += 4) {            \
+    const V x0 = x[i + 0], x1 = x[i + 1]; \
+    const V x2 = x[i + 2], x3 = x[i + 3]; \
+    POLY_START(V);                        \
+    for (size_t k = degree; k-- > 0;)     \
+      POLY_STEP(V, k)                     \
+    dst[i + 0] = r0;                      \
+    dst[i + 1] = r1;                      \
+    dst[i + 2] = r2;                      \
+    dst[i + 3] = r3;                      \
+  }                                       \
+  for (; i < n; i++)                      \
+    dst[i] = V##_poly(x[i], c, degree);   \
+})                                        \
+POLY_PAR(V##_poly, V, T)
+
+/*
+** The scalar batch works `W` lanes of `V` at a time, loaded and stored with
+** `V_load` and `V_store` so `x` and `dst` need no more than `T` alignment.
+*/
+
+#define POLY1(T, V, W) \
+\
+_sol_ \
+T T##_poly(T x, const T* c, size_t degree) { \
+  T r = c[degree];                           \
+  for (size_t k = degree; k-- > 0;)          \
+    r = T##_fma(r, x, c[k]);                 \
+  return r;                                  \
+}                                            \
+\
+SOL_KERNEL(T##_poly_n, (T* dst, const T* x, const T* c, size_t degree, size_t n), (dst, x, c, degree, n), { \
+  size_t i = 0;                           \
+  for (; i + 4 * W <= n; i += 4 * W) {    \
+    const V x0 = V##_load(x + i);         \
+    const V x1 = V##_load(x + i + W);     \
+    const V x2 = V##_load(x + i + 2 * W); \
+    const V x3 = V##_load(x + i + 3 * W); \
+    POLY_START(V);                        \
+    for (size_t k = degree; k-- > 0;)     \
+      POLY_STEP(V, k)                     \
+    V##_store(dst + i, r0);               \
+    V##_store(dst + i + W, r1);           \
+    V##_store(dst + i + 2 * W, r2);       \
+    V##_store(dst + i + 3 * W, r3);       \
+  }                                       \
+  for (; i < n; i++)                      \
+    dst[i] = T##_poly(x[i], c, degree);   \
+})                                        \
+POLY_PAR(T##_poly, T, T)
+
+POLY1(f32, f32x8, 8)
+POLY1(f64, f64x8, 8)
+
+POLY(f32, f32x2)
+POLY(f32, f32x3)
+POLY(f32, f32x4)
+POLY(f32, f32x8)
+POLY(f32, f32x16)
+
+POLY(f64, f64x2)
+POLY(f64, f64x3)
+POLY(f64, f64x4)
+POLY(f64, f64x8)
+POLY(f64, f64x16)
+
+#undef POLY
+#undef POLY1
+#undef POLY_STEP
+#undef POLY_START
+#undef POLY_PAR
+
+#endif /* SOL_POLY_H */
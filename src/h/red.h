@@ -0,0 +1,322 @@
+/*
+** red.h | The Sol Vector Library | Code for whole-array reductions.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_RED_H
+#define SOL_RED_H
+
+/*
+** Convenience Macros
+**
+** A reduction carried in one register waits on the previous add every step,
+** so RED_LOOP keeps four independent `V` accumulators `a0` to `a3`, folds one
+** more `V` into `a0` at a time until fewer than `W` elements are left, and
+** then lets the caller finish the tail. `STEP(V, A, I)` folds the `W`
+** elements starting at index `I` into `A`.
+*/
+
+#define RED_LOOP(V, W, STEP)           \
+  size_t i = 0;                        \
+  for (; i + 4 * W <= n; i += 4 * W) { \
+    STEP(V, a0, i);                    \
+    STEP(V, a1, i + W);                \
+    STEP(V, a2, i + 2 * W);            \
+    STEP(V, a3, i + 3 * W);            \
+  }                                    \
+  for (; i + W <= n; i += W)           \
+    STEP(V, a0, i)
+
+#define RED_LD(V, X, P)  \
+  V X;                    \
+  memcpy(&X, P, sizeof X)
+
+#define RED_SUM(V, A, I) { RED_LD(V, x_, v + (I)); A = V##_add(A, x_); }
+#define RED_MIN(V, A, I) { RED_LD(V, x_, v + (I)); A = V##_min(x_, A); }
+#define RED_MAX(V, A, I) { RED_LD(V, x_, v + (I)); A = V##_max(x_, A); }
+
+#define RED_DOT(V, A, I) { \
+  RED_LD(V, x_, a + (I));  \
+  RED_LD(V, y_, b + (I));  \
+  A = V##_fma(x_, y_, A);  \
+}
+
+/*
+** Without AVX, GCC compares 32-byte vectors one lane at a time, so `RED_MM`
+** picks the 16-byte types for `T_min_n`, `T_max_n` and `T_minmax_n` there.
+** Adds and multiplies split into halves fine, so the sums always use the
+** wider types. RED_ expands `RED_MM` before the pasting in RED.
+*/
+
+#ifdef __AVX__
+  #define RED_MM(A, WA, B, WB) A, WA
+#else
+  #define RED_MM(A, WA, B, WB) B, WB
+#endif
+
+#define RED_(...) RED(__VA_ARGS__)
+
+/*
+** Kahan summation carries the rounding error of each add in `c` and feeds it
+** back into the next, so the error no longer grows with `n`. It relies on
+** the adds being done as written; -ffast-math and -fassociative-math let the
+** compiler cancel the correction out.
+*/
+
+#define RED_KAHAN(V, S, C, X) {    \
+  const V y_ = V##_sub(X, C);      \
+  const V t_ = V##_add(S, y_);     \
+  C = V##_sub(V##_sub(t_, S), y_); \
+  S = t_;                          \
+}
+
+#define RED_KAHAN1(T, S, C, X) { \
+  const T y_ = (X) - C; \
+  const T t_ = S + y_;  \
+  C = (t_ - S) - y_;    \
+  S = t_;               \
+}
+
+/*
+** Under SOL_THREADS, RED_PAR adds `T_F_par_n`, which reduces each chunk into
+** its own slot with `T_F_n` and then folds the slots in order with `T_C_n`,
+** so the result doesn't depend on which thread ran which chunk. `CALL` is the
+** per-chunk reduction of `x->a` (and `x->b`) over `[lo, hi)`, and `ARGS` the
+** whole-array call made when there is only one chunk. The chunk size is read
+** once and handed to PAR_for, so the slots always match the chunks.
+** RED_PAR_MINMAX does the same for `T_minmax_n`, with two slots per chunk.
+*/
+
+#ifdef SOL_THREADS
+  #define RED_PAR_CTX(T) \
+    typedef struct { const T* a; const T* b; T* part; size_t size; } T##_red_ctx;
+
+  #define RED_PAR(T, F, C, P, ARGS, A, B, CALL)                             \
+    static inline void T##_##F##_par_run(void* ctx, size_t lo, size_t hi) { \
+      const T##_red_ctx* x = (const T##_red_ctx*) ctx;                      \
+      x->part[lo / x->size] = CALL;                                         \
+    }                                                                       \
+    _sol_ T T##_##F##_par_n P {                                             \
+      const size_t size = sol_chunk_get(n);                                 \
+      const size_t chunks = (n + size - 1) / size;                          \
+      T* part = (chunks > 1) ? (T*) malloc(chunks * sizeof(T)) : NULL;      \
+      if (!part)                                                            \
+        return T##_##F##_n ARGS;                                            \
+      T##_red_ctx x = {A, B, part, size};                                   \
+      PAR_for(n, size, T##_##F##_par_run, &x);                              \
+      const T out = T##_##C##_n(part, chunks);                              \
+      free(part);                                                           \
+      return out;                                                           \
+    }
+
+  #define RED_PAR_MINMAX(T)                                                  \
+    static inline void T##_minmax_par_run(void* ctx, size_t lo, size_t hi) { \
+      const T##_red_ctx* x = (const T##_red_ctx*) ctx;                       \
+      T* p = x->part + 2 * (lo / x->size);                                   \
+      T##_minmax_n(p, p + 1, x->a + lo, hi - lo);                            \
+    }                                                                        \
+    _sol_ void T##_minmax_par_n(T* lo, T* hi, const T* v, size_t n) {        \
+      const size_t size = sol_chunk_get(n);                                  \
+      const size_t chunks = (n + size - 1) / size;                           \
+      T* part = (chunks > 1) ? (T*) malloc(2 * chunks * sizeof(T)) : NULL;   \
+      if (!part) {                                                           \
+        T##_minmax_n(lo, hi, v, n);                                          \
+        return;                                                              \
+      }                                                                      \
+      T##_red_ctx x = {v, NULL, part, size};                                 \
+      PAR_for(n, size, T##_minmax_par_run, &x);                              \
+      T l = part[0], h = part[1];                                            \
+      for (size_t k = 1; k < chunks; k++) {                                  \
+        l = (part[2 * k] < l) ? part[2 * k] : l;                             \
+        h = (part[2 * k + 1] > h) ? part[2 * k + 1] : h;                     \
+      }                                                                      \
+      free(part);                                                            \
+      *lo = l;                                                               \
+      *hi = h;                                                               \
+    }
+#else
+  #define RED_PAR_CTX(T)
+  #define RED_PAR(T, F, C, P, ARGS, A, B, CALL)
+  #define RED_PAR_MINMAX(T)
+#endif
+
+/*
+** Definer Macros
+**
+** `V` is `W` lanes of `T`, as is `VM` with `WM` lanes, and `LO` and `HI` are
+** the smallest and largest values of `T`, returned by `T_max_n` and `T_min_n`
+** for an empty array.
+**
+** `V_min` and `V_max` return their second operand when either is NaN, so the
+** accumulators go second: a NaN element is skipped, the same as in the tail.
+*/
+
+#define RED(T, V, W, VM, WM, LO, HI) \
+\
+SOL_KERNEL_R(T, T##_sum_n, (const T* v, size_t n), (v, n), { \
+  V a0 = V##_zero(), a1 = a0, a2 = a0, a3 = a0;               \
+  RED_LOOP(V, W, RED_SUM);                                    \
+  T out = V##_sum(V##_add(V##_add(a0, a1), V##_add(a2, a3))); \
+  for (; i < n; i++)                                          \
+    out = (T) (out + v[i]);                                   \
+  return out;                                                 \
+})                                                            \
+\
+SOL_KERNEL_R(T, T##_dot_n, (const T* a, const T* b, size_t n), (a, b, n), { \
+  V a0 = V##_zero(), a1 = a0, a2 = a0, a3 = a0;               \
+  RED_LOOP(V, W, RED_DOT);                                    \
+  T out = V##_sum(V##_add(V##_add(a0, a1), V##_add(a2, a3))); \
+  for (; i < n; i++)                                          \
+    out = (T) (out + a[i] * b[i]);                            \
+  return out;                                                 \
+})                                                            \
+\
+SOL_KERNEL_R(T, T##_min_n, (const T* v, size_t n), (v, n), { \
+  VM a0 = VM##_setf(HI), a1 = a0, a2 = a0, a3 = a0;          \
+  RED_LOOP(VM, WM, RED_MIN);                                 \
+  const VM m = VM##_min(VM##_min(a0, a1), VM##_min(a2, a3)); \
+  T out = HI;                                                \
+  for (size_t k = 0; k < WM; k++)                            \
+    out = (vec(m)[k] < out) ? vec(m)[k] : out;               \
+  for (; i < n; i++)                                         \
+    out = (v[i] < out) ? v[i] : out;                         \
+  return out;                                                \
+})                                                           \
+\
+SOL_KERNEL_R(T, T##_max_n, (const T* v, size_t n), (v, n), { \
+  VM a0 = VM##_setf(LO), a1 = a0, a2 = a0, a3 = a0;          \
+  RED_LOOP(VM, WM, RED_MAX);                                 \
+  const VM m = VM##_max(VM##_max(a0, a1), VM##_max(a2, a3)); \
+  T out = LO;                                                \
+  for (size_t k = 0; k < WM; k++)                            \
+    out = (vec(m)[k] > out) ? vec(m)[k] : out;               \
+  for (; i < n; i++)                                         \
+    out = (v[i] > out) ? v[i] : out;                         \
+  return out;                                                \
+})                                                           \
+\
+SOL_KERNEL(T##_minmax_n, (T* lo, T* hi, const T* v, size_t n), (lo, hi, v, n), { \
+  VM a0 = VM##_setf(HI), a1 = a0;                      \
+  VM b0 = VM##_setf(LO), b1 = b0;                      \
+  size_t i = 0;                                        \
+  for (; i + 2 * WM <= n; i += 2 * WM) {               \
+    RED_LD(VM, x0, v + i);                             \
+    RED_LD(VM, x1, v + i + WM);                        \
+    a0 = VM##_min(x0, a0);                             \
+    a1 = VM##_min(x1, a1);                             \
+    b0 = VM##_max(x0, b0);                             \
+    b1 = VM##_max(x1, b1);                             \
+  }                                                    \
+  const VM m = VM##_min(a0, a1), M = VM##_max(b0, b1); \
+  T l = HI, h = LO;                                    \
+  for (size_t k = 0; k < WM; k++) {                    \
+    l = (vec(m)[k] < l) ? vec(m)[k] : l;               \
+    h = (vec(M)[k] > h) ? vec(M)[k] : h;               \
+  }                                                    \
+  for (; i < n; i++) {                                 \
+    l = (v[i] < l) ? v[i] : l;                         \
+    h = (v[i] > h) ? v[i] : h;                         \
+  }                                                    \
+  *lo = l;                                             \
+  *hi = h;                                             \
+})                                                   \
+\
+RED_PAR_CTX(T) \
+RED_PAR(T, sum, sum, (const T* v, size_t n), (v, n), v, NULL, \
+        T##_sum_n(x->a + lo, hi - lo)) \
+RED_PAR(T, dot, sum, (const T* a, const T* b, size_t n), (a, b, n), a, b, \
+        T##_dot_n(x->a + lo, x->b + lo, hi - lo)) \
+RED_PAR(T, min, min, (const T* v, size_t n), (v, n), v, NULL, \
+        T##_min_n(x->a + lo, hi - lo)) \
+RED_PAR(T, max, max, (const T* v, size_t n), (v, n), v, NULL, \
+        T##_max_n(x->a + lo, hi - lo)) \
+RED_PAR_MINMAX(T)
+
+/*
+** The compensated forms are only defined for the floating types. Each of two
+** accumulators keeps its own error term per lane; the lanes are then summed
+** with the same correction, errors last.
+*/
+
+#define RED_PRECISE(T, V, W) \
+\
+SOL_KERNEL_R(T, T##_sum_precise_n, (const T* v, size_t n), (v, n), { \
+  V s0 = V##_zero(), s1 = s0, c0 = s0, c1 = s0; \
+  size_t i = 0;                                 \
+  for (; i + 2 * W <= n; i += 2 * W) {          \
+    RED_KAHAN(V, s0, c0, V##_load(v + i))       \
+    RED_KAHAN(V, s1, c1, V##_load(v + i + W))   \
+  }                                             \
+  T s = 0, c = 0;                               \
+  for (size_t k = 0; k < W; k++) {              \
+    RED_KAHAN1(T, s, c, vec(s0)[k])             \
+    RED_KAHAN1(T, s, c, vec(s1)[k])             \
+  }                                             \
+  for (; i < n; i++)                            \
+    RED_KAHAN1(T, s, c, v[i])                   \
+  for (size_t k = 0; k < W; k++) {              \
+    RED_KAHAN1(T, s, c, -vec(c0)[k])            \
+    RED_KAHAN1(T, s, c, -vec(c1)[k])            \
+  }                                             \
+  return s - c;                                 \
+})                                              \
+\
+SOL_KERNEL_R(T, T##_dot_precise_n, (const T* a, const T* b, size_t n), (a, b, n), { \
+  V s0 = V##_zero(), s1 = s0, c0 = s0, c1 = s0;                             \
+  size_t i = 0;                                                             \
+  for (; i + 2 * W <= n; i += 2 * W) {                                      \
+    RED_KAHAN(V, s0, c0, V##_mul(V##_load(a + i), V##_load(b + i)))         \
+    RED_KAHAN(V, s1, c1, V##_mul(V##_load(a + i + W), V##_load(b + i + W))) \
+  }                                                                         \
+  T s = 0, c = 0;                                                           \
+  for (size_t k = 0; k < W; k++) {                                          \
+    RED_KAHAN1(T, s, c, vec(s0)[k])                                         \
+    RED_KAHAN1(T, s, c, vec(s1)[k])                                         \
+  }                                                                         \
+  for (; i < n; i++)                                                        \
+    RED_KAHAN1(T, s, c, a[i] * b[i])                                        \
+  for (size_t k = 0; k < W; k++) {                                          \
+    RED_KAHAN1(T, s, c, -vec(c0)[k])                                        \
+    RED_KAHAN1(T, s, c, -vec(c1)[k])                                        \
+  }                                                                         \
+  return s - c;                                                             \
+})                                                                        \
+\
+RED_PAR(T, sum_precise, sum_precise, (const T* v, size_t n), (v, n), v, NULL, \
+        T##_sum_precise_n(x->a + lo, hi - lo)) \
+RED_PAR(T, dot_precise, sum_precise, (const T* a, const T* b, size_t n), (a, b, n), a, b, \
+        T##_dot_precise_n(x->a + lo, x->b + lo, hi - lo))
+
+RED_(f32, f32x8, 8, RED_MM(f32x8, 8, f32x4, 4), -INFINITY, INFINITY)
+RED_(f64, f64x8, 8, RED_MM(f64x4, 4, f64x2, 2), -INFINITY, INFINITY)
+
+RED_(i8,  i8x16,  16, RED_MM(i8x16, 16, i8x16, 16), INT8_MIN,  INT8_MAX)
+RED_(i16, i16x16, 16, RED_MM(i16x16, 16, i16x8, 8), INT16_MIN, INT16_MAX)
+RED_(i32, i32x8,  8,  RED_MM(i32x8, 8, i32x4, 4),   INT32_MIN, INT32_MAX)
+RED_(i64, i64x8,  8,  RED_MM(i64x4, 4, i64x2, 2),   INT64_MIN, INT64_MAX)
+
+RED_(u8,  u8x16,  16, RED_MM(u8x16, 16, u8x16, 16), 0, UINT8_MAX)
+RED_(u16, u16x16, 16, RED_MM(u16x16, 16, u16x8, 8), 0, UINT16_MAX)
+RED_(u32, u32x8,  8,  RED_MM(u32x8, 8, u32x4, 4),   0, UINT32_MAX)
+RED_(u64, u64x8,  8,  RED_MM(u64x4, 4, u64x2, 2),   0, UINT64_MAX)
+
+RED_PRECISE(f32, f32x8, 8)
+RED_PRECISE(f64, f64x8, 8)
+
+#undef RED
+#undef RED_PRECISE
+#undef RED_
+#undef RED_MM
+#undef RED_LD
+#undef RED_LOOP
+#undef RED_SUM
+#undef RED_DOT
+#undef RED_MIN
+#undef RED_MAX
+#undef RED_KAHAN
+#undef RED_KAHAN1
+#undef RED_PAR
+#undef RED_PAR_CTX
+#undef RED_PAR_MINMAX
+
+#endif /* SOL_RED_H */
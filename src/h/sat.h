@@ -0,0 +1,273 @@
+/*
+** sat.h | The Sol Vector Library | Saturating and widening small integer math.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_SAT_H
+#define SOL_SAT_H
+
+/*
+** Convenience Macros
+**
+** SAT_LOOP evaluates `E` on each lane `p` of `A` and `q` of `B`, padding
+** included, with the lanes widened to `S` first so nothing wraps. SAT_X86 is
+** the fast path: when `V` is exactly one SSE2 or AVX2 register the whole
+** vector goes through the named intrinsic and the function returns early;
+** otherwise it expands to nothing. Not every lane type has an `avg`, `mulhi`
+** or `pack` instruction, so those go through the SAT_AVG_, SAT_MULHI_ and
+** SAT_PACK_ tables, whose entries are empty where there is none.
+*/
+
+#define SAT_CLAMP(X, LO, HI) ((X) < (LO) ? (LO) : (X) > (HI) ? (HI) : (X))
+
+#define SAT_LOOP(T, S, O, A, B, E)                     \
+  for (size_t i = 0; i < sizeof(O) / sizeof(T); i++) { \
+    const S p = vec(A)[i], q = vec(B)[i];              \
+    vec(O)[i] = (T) (E);                               \
+  }
+
+#define SAT_X86_DO(R, F, O, A, B) { \
+  R a_, b_;                         \
+  memcpy(&a_, &A, sizeof(A));       \
+  memcpy(&b_, &B, sizeof(B));       \
+  const R r_ = F(a_, b_);           \
+  memcpy(&O, &r_, sizeof(O));       \
+  return O;                         \
+}
+
+#define SAT_X86_PACK(F, O, V) {                      \
+  __m128i l_, h_;                                    \
+  memcpy(&l_, &V, sizeof(V) == 32 ? 16 : sizeof(V)); \
+  h_ = l_;                                           \
+  if (sizeof(V) == 32)                               \
+    memcpy(&h_, (const char*) &V + 16, 16);          \
+  const __m128i r_ = F(l_, h_);                      \
+  memcpy(&O, &r_, sizeof(O));                        \
+  return O;                                          \
+}
+
+#if defined(__AVX2__)
+  #define SAT_X86(F, V, O, A, B)                                  \
+    if (sizeof(V) == 32) SAT_X86_DO(__m256i, _mm256_##F, O, A, B) \
+    if (sizeof(V) == 16) SAT_X86_DO(__m128i, _mm_##F, O, A, B)
+#elif defined(__SSE2__)
+  #define SAT_X86(F, V, O, A, B) \
+    if (sizeof(V) == 16) SAT_X86_DO(__m128i, _mm_##F, O, A, B)
+#else
+  #define SAT_X86(F, V, O, A, B)
+#endif
+
+#if defined(__SSE2__)
+  #define SAT_PACK_X86(F, V, O, P) \
+    if (sizeof(V) == 16 || sizeof(V) == 32) SAT_X86_PACK(_mm_##F, O, P)
+#else
+  #define SAT_PACK_X86(F, V, O, P)
+#endif
+
+#define SAT_AVG_epi8(V, O, A, B)
+#define SAT_AVG_epi16(V, O, A, B)
+#define SAT_AVG_epu8(V, O, A, B) SAT_X86(avg_epu8, V, O, A, B)
+#define SAT_AVG_epu16(V, O, A, B) SAT_X86(avg_epu16, V, O, A, B)
+
+#define SAT_MULHI_epi8(V, O, A, B)
+#define SAT_MULHI_epi16(V, O, A, B) SAT_X86(mulhi_epi16, V, O, A, B)
+#define SAT_MULHI_epu8(V, O, A, B)
+#define SAT_MULHI_epu16(V, O, A, B) SAT_X86(mulhi_epu16, V, O, A, B)
+
+#define SAT_PACK_packs_epi16(V, O, P) SAT_PACK_X86(packs_epi16, V, O, P)
+#define SAT_PACK_packus_epi16(V, O, P) SAT_PACK_X86(packus_epi16, V, O, P)
+#define SAT_PACK_packs_epi32(V, O, P) SAT_PACK_X86(packs_epi32, V, O, P)
+#ifdef __SSE4_1__
+  #define SAT_PACK_packus_epi32(V, O, P) SAT_PACK_X86(packus_epi32, V, O, P)
+#else
+  #define SAT_PACK_packus_epi32(V, O, P)
+#endif
+
+#if defined(SOL_GNU) && __has_builtin(__builtin_convertvector)
+  #define SAT_WIDEN(T, V, VW, O, A) O = __builtin_convertvector(A, VW)
+#else
+  #define SAT_WIDEN(T, V, VW, O, A)                    \
+    for (size_t i = 0; i < sizeof(V) / sizeof(T); i++) \
+      vec(O)[i] = vec(A)[i]
+#endif
+
+/*
+** Definer Macros
+**
+** `X` names the lane type the way the x86 intrinsics do. `S` is a scalar wide
+** enough to hold the product of two lanes, and `VW` is the vector of `S` with
+** as many lanes as `V`.
+*/
+
+#define SAT(T, V, X, LO, HI, S, VW) \
+\
+/* Saturating Math */ \
+\
+_sol_ \
+V V##_adds(V a, V b) {                                   \
+  V out;                                                 \
+  SAT_X86(adds_##X, V, out, a, b)                        \
+  SAT_LOOP(T, i32, out, a, b, SAT_CLAMP(p + q, LO, HI)); \
+  return out;                                            \
+}                                                        \
+\
+_sol_ \
+V V##_subs(V a, V b) {                                   \
+  V out;                                                 \
+  SAT_X86(subs_##X, V, out, a, b)                        \
+  SAT_LOOP(T, i32, out, a, b, SAT_CLAMP(p - q, LO, HI)); \
+  return out;                                            \
+}                                                        \
+\
+_sol_ \
+V V##_avg(V a, V b) {                            \
+  V out;                                         \
+  SAT_AVG_##X(V, out, a, b)                      \
+  SAT_LOOP(T, i32, out, a, b, (p + q + 1) >> 1); \
+  return out;                                    \
+}                                                \
+\
+_sol_ \
+V V##_mulhi(V a, V b) {                                  \
+  V out;                                                 \
+  SAT_MULHI_##X(V, out, a, b)                            \
+  SAT_LOOP(T, S, out, a, b, (p * q) >> (8 * sizeof(T))); \
+  return out;                                            \
+}                                                        \
+\
+/* Widening Math */ \
+\
+_sol_ \
+VW V##_widen(V v) {            \
+  VW out = {0};                \
+  SAT_WIDEN(T, V, VW, out, v); \
+  return out;                  \
+}                              \
+\
+_sol_ \
+VW V##_mulw(V a, V b) {                        \
+  return VW##_mul(V##_widen(a), V##_widen(b)); \
+}                                              \
+\
+_sol_ \
+VW V##_maddw(V a, V b, VW c) {                    \
+  return VW##_fma(V##_widen(a), V##_widen(b), c); \
+}                                                 \
+\
+/* Bulk Kernels */ \
+\
+SOL_N2(V##_adds, V, V) \
+SOL_N2(V##_subs, V, V) \
+SOL_N2(V##_avg, V, V)
+
+/*
+** `V_madd` multiplies the `i16` lanes of `a` and `b` and adds neighbouring
+** pairs of products into `i32` lanes, like `pmaddwd`. The one pair that can
+** overflow, both products being `-32768 * -32768`, wraps the same way.
+*/
+
+#define SAT_MADD(V, VH) \
+_sol_ \
+VH V##_madd(V a, V b) {                                    \
+  VH out;                                                  \
+  SAT_X86(madd_epi16, V, out, a, b)                        \
+  for (size_t i = 0; i < sizeof(out) / sizeof(i32); i++) { \
+    const i32 p = vec(a)[2 * i + 0] * vec(b)[2 * i + 0];   \
+    const i32 q = vec(a)[2 * i + 1] * vec(b)[2 * i + 1];   \
+    vec(out)[i] = (i32) ((u32) p + (u32) q);               \
+  }                                                        \
+  return out;                                              \
+}
+
+/*
+** `V_packs` and `V_packus` narrow each lane to half its width, clamping it to
+** the signed or unsigned range of the narrow type, like `packsswb` and
+** `packuswb`.
+*/
+
+#define SAT_PACK(T, V, N, VN, P, X, LO, HI) \
+_sol_ \
+VN V##_##P(V v) {                                    \
+  VN out;                                            \
+  SAT_PACK_##P##_##X(V, out, v)                      \
+  for (size_t i = 0; i < sizeof(V) / sizeof(T); i++) \
+    vec(out)[i] = (N) SAT_CLAMP(vec(v)[i], LO, HI);  \
+  return out;                                        \
+}
+
+SAT(i8, i8x2, epi8, INT8_MIN, INT8_MAX, i16, i16x2)
+SAT(i8, i8x3, epi8, INT8_MIN, INT8_MAX, i16, i16x3)
+SAT(i8, i8x4, epi8, INT8_MIN, INT8_MAX, i16, i16x4)
+SAT(i8, i8x8, epi8, INT8_MIN, INT8_MAX, i16, i16x8)
+SAT(i8, i8x16, epi8, INT8_MIN, INT8_MAX, i16, i16x16)
+
+SAT(i16, i16x2, epi16, INT16_MIN, INT16_MAX, i32, i32x2)
+SAT(i16, i16x3, epi16, INT16_MIN, INT16_MAX, i32, i32x3)
+SAT(i16, i16x4, epi16, INT16_MIN, INT16_MAX, i32, i32x4)
+SAT(i16, i16x8, epi16, INT16_MIN, INT16_MAX, i32, i32x8)
+SAT(i16, i16x16, epi16, INT16_MIN, INT16_MAX, i32, i32x16)
+
+SAT(u8, u8x2, epu8, 0, UINT8_MAX, u16, u16x2)
+SAT(u8, u8x3, epu8, 0, UINT8_MAX, u16, u16x3)
+SAT(u8, u8x4, epu8, 0, UINT8_MAX, u16, u16x4)
+SAT(u8, u8x8, epu8, 0, UINT8_MAX, u16, u16x8)
+SAT(u8, u8x16, epu8, 0, UINT8_MAX, u16, u16x16)
+
+SAT(u16, u16x2, epu16, 0, UINT16_MAX, u32, u32x2)
+SAT(u16, u16x3, epu16, 0, UINT16_MAX, u32, u32x3)
+SAT(u16, u16x4, epu16, 0, UINT16_MAX, u32, u32x4)
+SAT(u16, u16x8, epu16, 0, UINT16_MAX, u32, u32x8)
+SAT(u16, u16x16, epu16, 0, UINT16_MAX, u32, u32x16)
+
+SAT_MADD(i16x4, i32x2)
+SAT_MADD(i16x8, i32x4)
+SAT_MADD(i16x16, i32x8)
+
+SAT_PACK(i16, i16x2, i8, i8x2, packs, epi16, INT8_MIN, INT8_MAX)
+SAT_PACK(i16, i16x3, i8, i8x3, packs, epi16, INT8_MIN, INT8_MAX)
+SAT_PACK(i16, i16x4, i8, i8x4, packs, epi16, INT8_MIN, INT8_MAX)
+SAT_PACK(i16, i16x8, i8, i8x8, packs, epi16, INT8_MIN, INT8_MAX)
+SAT_PACK(i16, i16x16, i8, i8x16, packs, epi16, INT8_MIN, INT8_MAX)
+
+SAT_PACK(i16, i16x2, u8, u8x2, packus, epi16, 0, UINT8_MAX)
+SAT_PACK(i16, i16x3, u8, u8x3, packus, epi16, 0, UINT8_MAX)
+SAT_PACK(i16, i16x4, u8, u8x4, packus, epi16, 0, UINT8_MAX)
+SAT_PACK(i16, i16x8, u8, u8x8, packus, epi16, 0, UINT8_MAX)
+SAT_PACK(i16, i16x16, u8, u8x16, packus, epi16, 0, UINT8_MAX)
+
+SAT_PACK(i32, i32x2, i16, i16x2, packs, epi32, INT16_MIN, INT16_MAX)
+SAT_PACK(i32, i32x3, i16, i16x3, packs, epi32, INT16_MIN, INT16_MAX)
+SAT_PACK(i32, i32x4, i16, i16x4, packs, epi32, INT16_MIN, INT16_MAX)
+SAT_PACK(i32, i32x8, i16, i16x8, packs, epi32, INT16_MIN, INT16_MAX)
+SAT_PACK(i32, i32x16, i16, i16x16, packs, epi32, INT16_MIN, INT16_MAX)
+
+SAT_PACK(i32, i32x2, u16, u16x2, packus, epi32, 0, UINT16_MAX)
+SAT_PACK(i32, i32x3, u16, u16x3, packus, epi32, 0, UINT16_MAX)
+SAT_PACK(i32, i32x4, u16, u16x4, packus, epi32, 0, UINT16_MAX)
+SAT_PACK(i32, i32x8, u16, u16x8, packus, epi32, 0, UINT16_MAX)
+SAT_PACK(i32, i32x16, u16, u16x16, packus, epi32, 0, UINT16_MAX)
+
+#undef SAT
+#undef SAT_MADD
+#undef SAT_PACK
+#undef SAT_CLAMP
+#undef SAT_LOOP
+#undef SAT_X86_DO
+#undef SAT_X86_PACK
+#undef SAT_X86
+#undef SAT_PACK_X86
+#undef SAT_AVG_epi8
+#undef SAT_AVG_epi16
+#undef SAT_AVG_epu8
+#undef SAT_AVG_epu16
+#undef SAT_MULHI_epi8
+#undef SAT_MULHI_epi16
+#undef SAT_MULHI_epu8
+#undef SAT_MULHI_epu16
+#undef SAT_PACK_packs_epi16
+#undef SAT_PACK_packus_epi16
+#undef SAT_PACK_packs_epi32
+#undef SAT_PACK_packus_epi32
+#undef SAT_WIDEN
+
+#endif /* SOL_SAT_H */
@@ -0,0 +1,138 @@
+/*
+** swz.h | The Sol Vector Library | Shuffles and swizzles for every vector type.
+** https://github.com/davidgarland/sol
+*/
+
+#ifndef SOL_SWZ_H
+#define SOL_SWZ_H
+
+/*
+** Convenience Macros
+**
+** A shuffle is built lane by lane from reads of its sources. SWZ_PICK reads
+** lane `I` of `A` and `B` laid end to end, so `W` is the first lane of `B`.
+** Under SOL_GNU the lanes go into a vector literal, which GCC and Clang both
+** turn back into one shuffle (`shufps`, `unpcklps`, `pshufb`, `vpermpd` and
+** the like) once the indices are constants. SWZ_PAD fills the padding lane of
+** a GNU `Tx3` with lane 0 of the first source, which any shuffle can reach, so
+** it costs nothing and lets GCC merge the shuffle with its neighbours.
+** Otherwise the lanes are stored one at a time.
+*/
+
+#define SWZ_PICK(A, B, W, I) ((I) < (W) ? vec(A)[I] : vec(B)[(I) - (W)])
+
+#define SWZ_L2(A, B, W) SWZ_PICK(A, B, W, l0), SWZ_PICK(A, B, W, l1)
+#define SWZ_L3(A, B, W) SWZ_L2(A, B, W), SWZ_PICK(A, B, W, l2)
+#define SWZ_L4(A, B, W) SWZ_L3(A, B, W), SWZ_PICK(A, B, W, l3)
+#define SWZ_L8(A, B, W)                                          \
+  SWZ_L4(A, B, W), SWZ_PICK(A, B, W, l4), SWZ_PICK(A, B, W, l5), \
+  SWZ_PICK(A, B, W, l6), SWZ_PICK(A, B, W, l7)
+#define SWZ_L16(A, B, W)                                         \
+  SWZ_L8(A, B, W), SWZ_PICK(A, B, W, l8), SWZ_PICK(A, B, W, l9), \
+  SWZ_PICK(A, B, W, l10), SWZ_PICK(A, B, W, l11),                \
+  SWZ_PICK(A, B, W, l12), SWZ_PICK(A, B, W, l13),                \
+  SWZ_PICK(A, B, W, l14), SWZ_PICK(A, B, W, l15)
+
+#define SWZ_PAD2(X)
+#define SWZ_PAD3(X) , X
+#define SWZ_PAD4(X)
+#define SWZ_PAD8(X)
+#define SWZ_PAD16(X)
+
+#ifdef SOL_GNU
+  #define SWZ_RET(T, V, W, A, B) \
+    return (V) {SWZ_L##W(A, B, W) SWZ_PAD##W(vec(A)[0])}
+#else
+  #define SWZ_RET(T, V, W, A, B)           \
+    const T l_[W] = {SWZ_L##W(A, B, W)}; \
+    V out;                               \
+    memcpy(&out, l_, sizeof out);        \
+    return out
+#endif
+
+/*
+** Definer Macros
+**
+** Every index must name a lane: below `W` for `V_shuffle`, below `2 * W` for
+** `V_shuffle2`, and below `W` for `V_splat`.
+*/
+
+#define SWZ(T, V, W) \
+\
+_sol_ \
+V V##_shuffle(V v, SWZ_P##W) { \
+  SWZ_RET(T, V, W, v, v);      \
+}                              \
+\
+_sol_ \
+V V##_shuffle2(V a, V b, SWZ_P##W) { \
+  SWZ_RET(T, V, W, a, b);            \
+}                                    \
+\
+_sol_ \
+V V##_splat(V v, int i) {     \
+  return V##_setf(vec(v)[i]); \
+}
+
+/*
+** The named swizzles have constant indices, so they use
+** __builtin_shufflevector where the compiler has it: GCC splits a 256-bit
+** vector literal on SSE less well than it does a shuffle.
+*/
+
+#if defined(SOL_GNU) && __has_builtin(__builtin_shufflevector)
+  #define SWZ_CONST(V, W, ...) \
+    __builtin_shufflevector(v, v, __VA_ARGS__ SWZ_PAD##W(0))
+#else
+  #define SWZ_CONST(V, W, ...) V##_shuffle(v, __VA_ARGS__)
+#endif
+
+#define SWZ_NAMED(V, W, N, ...) \
+\
+_sol_ \
+V V##_##N(V v) {                        \
+  return SWZ_CONST(V, W, __VA_ARGS__); \
+}
+
+#define SWZ_NAMED2(V, N, ...) SWZ_NAMED(V, 2, N, __VA_ARGS__)
+#define SWZ_NAMED3(V, N, ...) SWZ_NAMED(V, 3, N, __VA_ARGS__)
+#define SWZ_NAMED4(V, N, ...) SWZ_NAMED(V, 4, N, __VA_ARGS__)
+
+#define SWZ_ALL(T)                                          \
+  SWZ(T, T##x2, 2) SWZ(T, T##x3, 3) SWZ(T, T##x4, 4)        \
+  SWZ(T, T##x8, 8) SWZ(T, T##x16, 16)                       \
+  SWZ_NAMES2(SWZ_NAMED2, T##x2) SWZ_NAMES3(SWZ_NAMED3, T##x3) \
+  SWZ_NAMES4(SWZ_NAMED4, T##x4)
+
+SWZ_ALL(f32)
+SWZ_ALL(f64)
+SWZ_ALL(i8)
+SWZ_ALL(i16)
+SWZ_ALL(i32)
+SWZ_ALL(i64)
+SWZ_ALL(u8)
+SWZ_ALL(u16)
+SWZ_ALL(u32)
+SWZ_ALL(u64)
+
+#undef SWZ
+#undef SWZ_NAMED
+#undef SWZ_NAMED2
+#undef SWZ_NAMED3
+#undef SWZ_NAMED4
+#undef SWZ_CONST
+#undef SWZ_ALL
+#undef SWZ_PICK
+#undef SWZ_L2
+#undef SWZ_L3
+#undef SWZ_L4
+#undef SWZ_L8
+#undef SWZ_L16
+#undef SWZ_RET
+#undef SWZ_PAD2
+#undef SWZ_PAD3
+#undef SWZ_PAD4
+#undef SWZ_PAD8
+#undef SWZ_PAD16
+
+#endif /* SOL_SWZ_H */
@@ -1,9 +1,45 @@
 /*
-** ux1.h | The Sol Vector Library | Code for u32 and u64.
+** ux1.h | The Sol Vector Library | Code for u8 to u64.
 ** https://github.com/davidgarland/sol
 */
 
 #ifndef SOL_UX1_H
 #define SOL_UX1_H
 
+/*
+** Definer Macros
+**
+** `W` is an unsigned type twice as wide as `T`, so the full product fits.
+*/
+
+#define UX1(T, W) \
+\
+_sol_ \
+T T##_mulhi(T a, T b) {                        \
+  return (T) (((W) a * b) >> (8 * sizeof(T))); \
+}
+
+UX1(u8,  u16)
+UX1(u16, u32)
+UX1(u32, u64)
+
+#undef UX1
+
+/*
+** There is no wider type for u64 in C99, so its high half is put together
+** from four 32-bit partial products unless the compiler has `__int128`.
+*/
+
+_sol_
+u64 u64_mulhi(u64 a, u64 b) {
+  #ifdef __SIZEOF_INT128__
+    return (u64) __extension__ (((unsigned __int128) a * b) >> 64);
+  #else
+    const u64 a0 = a & 0xffffffff, a1 = a >> 32;
+    const u64 b0 = b & 0xffffffff, b1 = b >> 32;
+    const u64 mid = ((a0 * b0) >> 32) + ((a1 * b0) & 0xffffffff) + a0 * b1;
+    return a1 * b1 + ((a1 * b0) >> 32) + (mid >> 32);
+  #endif
+}
+
 #endif /* SOL_UX1_H */
@@ -44,6 +44,11 @@ T V##_sum(V v) {                    \
 }                                   \
 \
 _sol_ \
+V V##_sq(V v) {         \
+  return V##_mul(v, v); \
+}                       \
+\
+_sol_ \
 V V##_add(V a, V b) {            \
   const V out = UX4_OP(a, +, b); \
   return out;                    \
@@ -68,7 +73,14 @@ V V##_subf(V v, T f) {            \
 }                                 \
 \
 _sol_ \
+V V##_fsub(T f, V v) {            \
+  const V out = UX4_FOP(f, -, v); \
+  return out;                     \
+}                                 \
+\
+_sol_ \
 V V##_mul(V a, V b) {            \
+  MUL_##T(V, a, b)               \
   const V out = UX4_OP(a, *, b); \
   return out;                    \
 }                                \
@@ -108,6 +120,23 @@ V V##_fms(V a, V b, V c) {              \
   const V out = UX4_OP2(a, *, b, -, c); \
   return out;                           \
 }                                       \
+\
+/* Bulk Kernels */ \
+\
+SOL_N1(V##_sum, T, V) \
+SOL_N1(V##_sq, V, V) \
+SOL_N2(V##_add, V, V) \
+SOL_N2F(V##_addf, V, V, T, f) \
+SOL_N2(V##_sub, V, V) \
+SOL_N2F(V##_subf, V, V, T, f) \
+SOL_NF2(V##_fsub, V, T, V) \
+SOL_N2(V##_mul, V, V) \
+SOL_N2F(V##_mulf, V, V, T, f) \
+SOL_N2(V##_div, V, V) \
+SOL_N2F(V##_divf, V, V, T, f) \
+SOL_NF2(V##_fdiv, V, T, V) \
+SOL_N3(V##_fma, V, V) \
+SOL_N3(V##_fms, V, V)
 
 UX4(u8,   u8x4)
 UX4(u16, u16x4)
@@ -10,19 +10,72 @@
 ** Dependencies
 */
 
-#ifdef __AVX__
+#if defined(__AVX__)
   #include <x86intrin.h>
+#elif defined(__SSE4_1__)
+  #include <smmintrin.h>
+#elif defined(__SSE2__)
+  #include <emmintrin.h>
+#elif defined(__SSE__)
+  #include <xmmintrin.h>
 #endif
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include <math.h>
 
+#ifdef SOL_THREADS
+  #include <pthread.h>
+  #include <stdlib.h>
+  #include <unistd.h>
+#endif
+
 /*
 ** Config Defaults
 */
 
 #define SOL_D_GNU true
+#define SOL_D_TRIG SOL_TRIG_FAST
+#define SOL_D_NORM SOL_NORM_EXACT
+#define SOL_D_FMA SOL_FMA_FAST
+#define SOL_D_STREAM (1 << 22)
+#define SOL_D_THREADS_MAX 64
+
+/*
+** Trig Tiers
+**
+** SOL_TRIG picks what the scalar T_sin, T_cos and T_tan call. Each tier can
+** also be called directly with the matching suffix.
+*/
+
+#define SOL_TRIG_FAST    1 /* _fast:    Bhaskara, ~1e-3 absolute error.   */
+#define SOL_TRIG_MID     2 /* _mid:     Taylor on [-pi/4, pi/4], ~1e-4.   */
+#define SOL_TRIG_PRECISE 3 /* _precise: Cody-Waite + minimax, a few ULP.  */
+
+/*
+** Norm Modes
+**
+** SOL_NORM picks what every _norm function calls. The fast mode multiplies by
+** T_rsqrt instead of taking a square root and dividing.
+*/
+
+#define SOL_NORM_EXACT 1 /* sqrt and divide, correctly rounded steps.   */
+#define SOL_NORM_FAST  2 /* _norm_fast: rsqrt + Newton, ~1e-6 relative. */
+
+/*
+** FMA Modes
+**
+** SOL_FMA picks how every floating _fma and _fms rounds `a * b + c`, along
+** with the _poly functions built on them. SOL_FMA_HW is 1 when the target has
+** a fused multiply-add instruction (`-mfma` on x86, or any target where the
+** compiler defines __FP_FAST_FMA), and 0 otherwise.
+*/
+
+#define SOL_FMA_FAST  1 /* One rounding where SOL_FMA_HW, two elsewhere.  */
+#define SOL_FMA_EXACT 2 /* Always one rounding; libm fma() without HW.   */
+#define SOL_FMA_SPLIT 3 /* Always two roundings, even where GCC fuses.   */
 
 /*
 ** Config Handling
@@ -34,10 +87,41 @@
   #undef SOL_GNU
 #endif
 
+#ifndef SOL_TRIG
+  #define SOL_TRIG SOL_D_TRIG
+#endif
+
+#ifndef SOL_NORM
+  #define SOL_NORM SOL_D_NORM
+#endif
+
+#ifndef SOL_STREAM
+  #define SOL_STREAM SOL_D_STREAM
+#endif
+
+#ifndef SOL_FMA
+  #define SOL_FMA SOL_D_FMA
+#endif
+
+#if defined(__FMA__) || defined(__FP_FAST_FMA)
+  #define SOL_FMA_HW 1
+#else
+  #define SOL_FMA_HW 0
+#endif
+
+#ifndef SOL_THREADS_MAX
+  #define SOL_THREADS_MAX SOL_D_THREADS_MAX
+#endif
+
 #ifndef __has_builtin
   #define __has_builtin(x) 0
 #endif
 
+#if defined(SOL_DISPATCH) && !(defined(SOL_GNU) && defined(__GNUC__) \
+    && (defined(__x86_64__) || defined(__i386__)))
+  #undef SOL_DISPATCH
+#endif
+
 /*
 ** Scalar Types
 */
@@ -52,6 +136,7 @@ typedef uint8_t  u8;
 typedef uint16_t u16;
 typedef uint32_t u32;
 typedef uint64_t u64;
+typedef uint16_t f16; /* IEEE half-precision bits. */
 
 /*
 ** Vector Types
@@ -64,87 +149,218 @@ typedef uint64_t u64;
   typedef f32 f32x2 vectype(f32, 2);
   typedef f32 f32x3 vectype(f32, 4);
   typedef f32 f32x4 vectype(f32, 4);
+  typedef f32 f32x8 vectype(f32, 8);
+  typedef f32 f32x16 vectype(f32, 16);
   /* f64 */
   typedef f64 f64x2 vectype(f64, 2);
   typedef f64 f64x3 vectype(f64, 4);
   typedef f64 f64x4 vectype(f64, 4);
+  typedef f64 f64x8 vectype(f64, 8);
+  typedef f64 f64x16 vectype(f64, 16);
   /* i8 */
   typedef i8 i8x2 vectype(i8, 2);
   typedef i8 i8x3 vectype(i8, 4);
   typedef i8 i8x4 vectype(i8, 4);
+  typedef i8 i8x8 vectype(i8, 8);
+  typedef i8 i8x16 vectype(i8, 16);
   /* i16 */
   typedef i16 i16x2 vectype(i16, 2);
   typedef i16 i16x3 vectype(i16, 4);
   typedef i16 i16x4 vectype(i16, 4);
+  typedef i16 i16x8 vectype(i16, 8);
+  typedef i16 i16x16 vectype(i16, 16);
   /* i32 */
   typedef i32 i32x2 vectype(i32, 2);
   typedef i32 i32x3 vectype(i32, 4);
   typedef i32 i32x4 vectype(i32, 4);
+  typedef i32 i32x8 vectype(i32, 8);
+  typedef i32 i32x16 vectype(i32, 16);
   /* i64 */
   typedef i64 i64x2 vectype(i64, 2);
   typedef i64 i64x3 vectype(i64, 4);
   typedef i64 i64x4 vectype(i64, 4);
+  typedef i64 i64x8 vectype(i64, 8);
+  typedef i64 i64x16 vectype(i64, 16);
   /* u8 */
   typedef u8 u8x2 vectype(u8, 2);
   typedef u8 u8x3 vectype(u8, 4);
   typedef u8 u8x4 vectype(u8, 4);
+  typedef u8 u8x8 vectype(u8, 8);
+  typedef u8 u8x16 vectype(u8, 16);
   /* u16 */
   typedef u16 u16x2 vectype(u16, 2);
   typedef u16 u16x3 vectype(u16, 4);
   typedef u16 u16x4 vectype(u16, 4);
+  typedef u16 u16x8 vectype(u16, 8);
+  typedef u16 u16x16 vectype(u16, 16);
   /* u32 */
   typedef u32 u32x2 vectype(u32, 2);
   typedef u32 u32x3 vectype(u32, 4);
   typedef u32 u32x4 vectype(u32, 4);
+  typedef u32 u32x8 vectype(u32, 8);
+  typedef u32 u32x16 vectype(u32, 16);
   /* u64 */
   typedef u64 u64x2 vectype(u64, 2);
   typedef u64 u64x3 vectype(u64, 4);
   typedef u64 u64x4 vectype(u64, 4);
+  typedef u64 u64x8 vectype(u64, 8);
+  typedef u64 u64x16 vectype(u64, 16);
 
   #undef vectype
 #else /* Scalar Execution */
   /* f32 */
-  typedef struct { f32 x, y; }       f32x2;
-  typedef struct { f32 x, y, z; }    f32x3;
-  typedef struct { f32 x, y, z, w; } f32x4;
+  typedef struct { f32 x, y; }              f32x2;
+  typedef struct { f32 x, y, z; }           f32x3;
+  typedef struct { f32 x, y, z, w; }        f32x4;
+  typedef struct { f32 x, y, z, w, r[4]; }  f32x8;
+  typedef struct { f32 x, y, z, w, r[12]; } f32x16;
   /* f64 */
-  typedef struct { f64 x, y; }       f64x2;
-  typedef struct { f64 x, y, z; }    f64x3;
-  typedef struct { f64 x, y, z, w; } f64x4;
+  typedef struct { f64 x, y; }              f64x2;
+  typedef struct { f64 x, y, z; }           f64x3;
+  typedef struct { f64 x, y, z, w; }        f64x4;
+  typedef struct { f64 x, y, z, w, r[4]; }  f64x8;
+  typedef struct { f64 x, y, z, w, r[12]; } f64x16;
   /* i8 */
-  typedef struct { i8 x, y; }        i8x2;
-  typedef struct { i8 x, y, z; }     i8x3;
-  typedef struct { i8 x, y, z, w; }  i8x4;
+  typedef struct { i8 x, y; }               i8x2;
+  typedef struct { i8 x, y, z; }            i8x3;
+  typedef struct { i8 x, y, z, w; }         i8x4;
+  typedef struct { i8 x, y, z, w, r[4]; }   i8x8;
+  typedef struct { i8 x, y, z, w, r[12]; }  i8x16;
   /* i16 */
-  typedef struct { i16 x, y; }       i16x2;
-  typedef struct { i16 x, y, z; }    i16x3;
-  typedef struct { i16 x, y, z, w; } i16x4;
+  typedef struct { i16 x, y; }              i16x2;
+  typedef struct { i16 x, y, z; }           i16x3;
+  typedef struct { i16 x, y, z, w; }        i16x4;
+  typedef struct { i16 x, y, z, w, r[4]; }  i16x8;
+  typedef struct { i16 x, y, z, w, r[12]; } i16x16;
   /* i32 */
-  typedef struct { i32 x, y; }       i32x2;
-  typedef struct { i32 x, y, z; }    i32x3;
-  typedef struct { i32 x, y, z, w; } i32x4;
+  typedef struct { i32 x, y; }              i32x2;
+  typedef struct { i32 x, y, z; }           i32x3;
+  typedef struct { i32 x, y, z, w; }        i32x4;
+  typedef struct { i32 x, y, z, w, r[4]; }  i32x8;
+  typedef struct { i32 x, y, z, w, r[12]; } i32x16;
   /* i64 */
-  typedef struct { i64 x, y; }       i64x2;
-  typedef struct { i64 x, y, z; }    i64x3;
-  typedef struct { i64 x, y, z, w; } i64x4;
+  typedef struct { i64 x, y; }              i64x2;
+  typedef struct { i64 x, y, z; }           i64x3;
+  typedef struct { i64 x, y, z, w; }        i64x4;
+  typedef struct { i64 x, y, z, w, r[4]; }  i64x8;
+  typedef struct { i64 x, y, z, w, r[12]; } i64x16;
   /* u8 */
-  typedef struct { u8 x, y; }        u8x2;
-  typedef struct { u8 x, y, z; }     u8x3;
-  typedef struct { u8 x, y, z, w; }  u8x4;
+  typedef struct { u8 x, y; }               u8x2;
+  typedef struct { u8 x, y, z; }            u8x3;
+  typedef struct { u8 x, y, z, w; }         u8x4;
+  typedef struct { u8 x, y, z, w, r[4]; }   u8x8;
+  typedef struct { u8 x, y, z, w, r[12]; }  u8x16;
   /* u16 */
-  typedef struct { u16 x, y; }       u16x2;
-  typedef struct { u16 x, y, z; }    u16x3;
-  typedef struct { u16 x, y, z, w; } u16x4;
+  typedef struct { u16 x, y; }              u16x2;
+  typedef struct { u16 x, y, z; }           u16x3;
+  typedef struct { u16 x, y, z, w; }        u16x4;
+  typedef struct { u16 x, y, z, w, r[4]; }  u16x8;
+  typedef struct { u16 x, y, z, w, r[12]; } u16x16;
   /* u32 */
-  typedef struct { u32 x, y; }       u32x2;
-  typedef struct { u32 x, y, z; }    u32x3;
-  typedef struct { u32 x, y, z, w; } u32x4;
+  typedef struct { u32 x, y; }              u32x2;
+  typedef struct { u32 x, y, z; }           u32x3;
+  typedef struct { u32 x, y, z, w; }        u32x4;
+  typedef struct { u32 x, y, z, w, r[4]; }  u32x8;
+  typedef struct { u32 x, y, z, w, r[12]; } u32x16;
   /* u64 */
-  typedef struct { u64 x, y; }       u64x2;
-  typedef struct { u64 x, y, z; }    u64x3;
-  typedef struct { u64 x, y, z, w; } u64x4;
+  typedef struct { u64 x, y; }              u64x2;
+  typedef struct { u64 x, y, z; }           u64x3;
+  typedef struct { u64 x, y, z, w; }        u64x4;
+  typedef struct { u64 x, y, z, w, r[4]; }  u64x8;
+  typedef struct { u64 x, y, z, w, r[12]; } u64x16;
+#endif
+
+/*
+** Packed Types
+**
+** Under SOL_GNU a `Tx3` takes the space of a `Tx4`. The packed types hold the
+** same three components with no padding, for keeping large arrays in memory;
+** they are converted to `Tx3` to compute with.
+*/
+
+typedef struct { f32 x, y, z; } f32x3p;
+typedef struct { f64 x, y, z; } f64x3p;
+
+/*
+** Half Types
+**
+** `f16` and the `f16xW` types only store IEEE half-precision values, packed
+** with no padding. They have no math of their own; convert them to `f32` or
+** `f32xW` to compute with.
+*/
+
+typedef struct { f16 x, y; }       f16x2;
+typedef struct { f16 x, y, z; }    f16x3;
+typedef struct { f16 x, y, z, w; } f16x4;
+
+/*
+** Divisor Types
+**
+** `Tdiv` is a divisor prepared once by `Tdiv_set`, after which dividing by it
+** takes a high multiply and a few shifts and adds instead of a divide.
+*/
+
+typedef struct { i8 mul, add, sub, fix; int sh; }   i8div;
+typedef struct { i16 mul, add, sub, fix; int sh; }  i16div;
+typedef struct { i32 mul, add, sub, fix; int sh; }  i32div;
+typedef struct { i64 mul, add, sub, fix; int sh; }  i64div;
+typedef struct { u8 mul; int sh1, sh2; }            u8div;
+typedef struct { u16 mul; int sh1, sh2; }           u16div;
+typedef struct { u32 mul; int sh1, sh2; }           u32div;
+typedef struct { u64 mul; int sh1, sh2; }           u64div;
+
+/*
+** Matrix Types
+**
+** Matrices are column-major arrays of vectors: `m.c[j]` is column `j`.
+*/
+
+typedef struct { f32x3 c[3]; } f32x3x3;
+typedef struct { f32x4 c[4]; } f32x4x4;
+typedef struct { f64x3 c[3]; } f64x3x3;
+typedef struct { f64x4 c[4]; } f64x4x4;
+
+/*
+** Lane Types
+**
+** A lane vector is the widest register Sol computes with at once: 8 f32s or 4
+** f64s under SOL_GNU (one ymm register with AVX), and a single scalar
+** otherwise. The structure-of-arrays kernels process one lane vector per
+** step, so they never need a horizontal add or a shuffle.
+*/
+
+#ifdef SOL_GNU
+  typedef f32 f32l __attribute__((vector_size(32)));
+  typedef f64 f64l __attribute__((vector_size(32)));
+  typedef i32 i32l __attribute__((vector_size(32)));
+  typedef u32 u32l __attribute__((vector_size(32)));
+  typedef u64 u64l __attribute__((vector_size(32)));
+#else
+  typedef f32 f32l;
+  typedef f64 f64l;
+  typedef i32 i32l;
+  typedef u32 u32l;
+  typedef u64 u64l;
 #endif
 
+/*
+** Structure-of-Arrays Types
+**
+** `TxWs` is a view over `W` separate streams of `T`, one per component. It
+** does not own its memory. `TxWl` is one lane vector's worth of such a view
+** loaded into registers.
+*/
+
+typedef struct { f32* x; f32* y; }         f32x2s;
+typedef struct { f32* x; f32* y; f32* z; } f32x3s;
+typedef struct { f64* x; f64* y; }         f64x2s;
+typedef struct { f64* x; f64* y; f64* z; } f64x3s;
+
+typedef struct { f32l x, y; }    f32x2l;
+typedef struct { f32l x, y, z; } f32x3l;
+typedef struct { f64l x, y; }    f64x2l;
+typedef struct { f64l x, y, z; } f64x3l;
+
 /*
 ** Vector Scalar Accessors
 */
@@ -186,24 +402,54 @@ static const f64 f64_tau   = f64_pi * 2.0;
 static const f64 f64_pi_2  = f64_pi / 2.0;
 static const f64 f64_pi_sq = f64_pi * f64_pi;
 
+static const size_t f32l_w = sizeof(f32l) / sizeof(f32);
+static const size_t f64l_w = sizeof(f64l) / sizeof(f64);
+
 /*
 ** Prototypes
 */
 
-#define _sol_ static inline
+/*
+** Vectors wider than 16 bytes are passed differently with and without AVX, so
+** when dispatched kernels are compiled for several instruction sets, inlining
+** is forced to keep such values from crossing between them.
+*/
+
+#ifdef SOL_DISPATCH
+  #define _sol_ static inline __attribute__((always_inline))
+#else
+  #define _sol_ static inline
+#endif
 
 #define FX1(T) \
 \
 _sol_ T T##_sq(T f);               \
 _sol_ T T##_sqrt(T f);             \
+_sol_ T T##_rsqrt(T f);            \
 _sol_ T T##_abs(T f);              \
 _sol_ T T##_neg(T f);              \
 _sol_ T T##_neg_if(T f, u64 cond); \
+_sol_ T T##_floor(T f);            \
 _sol_ T T##_mod(T x, T y);         \
+_sol_ T T##_fma(T a, T b, T c);    \
+_sol_ T T##_fms(T a, T b, T c);    \
 \
 _sol_ T T##_sin(T f);  \
 _sol_ T T##_cos(T f);  \
 _sol_ T T##_tan(T f);  \
+\
+_sol_ T T##_sin_fast(T f);                      \
+_sol_ T T##_cos_fast(T f);                      \
+_sol_ T T##_tan_fast(T f);                      \
+_sol_ T T##_sin_mid(T f);                       \
+_sol_ T T##_cos_mid(T f);                       \
+_sol_ T T##_tan_mid(T f);                       \
+_sol_ void T##_sincos_mid(T f, T* s, T* c);     \
+_sol_ T T##_sin_precise(T f);                   \
+_sol_ T T##_cos_precise(T f);                   \
+_sol_ T T##_tan_precise(T f);                   \
+_sol_ void T##_sincos_precise(T f, T* s, T* c); \
+\
 _sol_ T T##_asin(T f); \
 _sol_ T T##_acos(T f); \
 _sol_ T T##_atan(T f); \
@@ -224,6 +470,7 @@ _sol_ V V##_rot(V v, T rad); \
 _sol_ V V##_scale(V v, T f); \
 \
 _sol_ V V##_norm(V v);       \
+_sol_ V V##_norm_fast(V v);  \
 _sol_ T V##_mag(V v);        \
 _sol_ V V##_proj(V a, V b);  \
 _sol_ V V##_rej(V a, V b);   \
@@ -245,7 +492,32 @@ _sol_ V V##_div(V a, V b);      \
 _sol_ V V##_divf(V v, T f);     \
 _sol_ V V##_fdiv(T f, V v);     \
 _sol_ V V##_fma(V a, V b, V c); \
-_sol_ V V##_fms(V a, V b, V c);
+_sol_ V V##_fms(V a, V b, V c); \
+\
+_sol_ void V##_rot_n(V* dst, const V* v, T rad, size_t n);                  \
+_sol_ void V##_scale_n(V* dst, const V* v, T f, size_t n);                  \
+_sol_ void V##_norm_n(V* dst, const V* v, size_t n);                        \
+_sol_ void V##_norm_fast_n(V* dst, const V* v, size_t n);                   \
+_sol_ void V##_mag_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_proj_n(V* dst, const V* a, const V* b, size_t n);            \
+_sol_ void V##_rej_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_angle_n(T* dst, const V* a, const V* b, size_t n);           \
+_sol_ void V##_cross_n(T* dst, const V* a, const V* b, size_t n);           \
+_sol_ void V##_dot_n(T* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_sum_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sq_n(V* dst, const V* v, size_t n);                          \
+_sol_ void V##_add_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_addf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_sub_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_subf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fsub_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_mul_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_mulf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_div_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_divf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fdiv_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_fma_n(V* dst, const V* a, const V* b, const V* c, size_t n); \
+_sol_ void V##_fms_n(V* dst, const V* a, const V* b, const V* c, size_t n);
 
 FX2(f32, f32x2)
 FX2(f64, f64x2)
@@ -262,6 +534,7 @@ _sol_ V V##_rot(V v, T##x4 q);  \
 _sol_ V V##_scale(V v, T f); \
 \
 _sol_ V V##_norm(V v);       \
+_sol_ V V##_norm_fast(V v);  \
 _sol_ T V##_mag(V v);        \
 _sol_ V V##_proj(V a, V b);  \
 _sol_ V V##_rej(V a, V b);   \
@@ -276,6 +549,7 @@ _sol_ V V##_add(V a, V b);      \
 _sol_ V V##_addf(V v, T f);     \
 _sol_ V V##_sub(V a, V b);      \
 _sol_ V V##_subf(V v, T f);     \
+_sol_ V V##_fsub(T f, V v);     \
 _sol_ V V##_mul(V a, V b);      \
 _sol_ V V##_mulf(V v, T f);     \
 _sol_ V V##_div(V a, V b);      \
@@ -284,7 +558,30 @@ _sol_ V V##_fdiv(T f, V v);     \
 _sol_ V V##_fma(V a, V b, V c); \
 _sol_ V V##_fms(V a, V b, V c); \
 \
-_sol_ V V##_yzx(V v);
+_sol_ void V##_rot_n(V* dst, const V* v, T##x4 q, size_t n);                \
+_sol_ void V##_scale_n(V* dst, const V* v, T f, size_t n);                  \
+_sol_ void V##_norm_n(V* dst, const V* v, size_t n);                        \
+_sol_ void V##_norm_fast_n(V* dst, const V* v, size_t n);                   \
+_sol_ void V##_mag_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_proj_n(V* dst, const V* a, const V* b, size_t n);            \
+_sol_ void V##_rej_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_angle_n(T* dst, const V* a, const V* b, size_t n);           \
+_sol_ void V##_cross_n(V* dst, const V* a, const V* b, size_t n);           \
+_sol_ void V##_dot_n(T* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_sum_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sq_n(V* dst, const V* v, size_t n);                          \
+_sol_ void V##_add_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_addf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_sub_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_subf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fsub_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_mul_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_mulf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_div_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_divf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fdiv_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_fma_n(V* dst, const V* a, const V* b, const V* c, size_t n); \
+_sol_ void V##_fms_n(V* dst, const V* a, const V* b, const V* c, size_t n);
 
 FX3(f32, f32x3)
 FX3(f64, f64x3)
@@ -300,6 +597,7 @@ _sol_ V V##_zero(void);              \
 _sol_ V V##_scale(V v, T f); \
 \
 _sol_ V V##_norm(V v); \
+_sol_ V V##_norm_fast(V v); \
 _sol_ T V##_mag(V v); \
 \
 _sol_ T V##_sum(V v);           \
@@ -317,12 +615,128 @@ _sol_ V V##_divf(V v, T f);     \
 _sol_ V V##_fdiv(T f, V v);     \
 _sol_ V V##_fma(V a, V b, V c); \
 _sol_ V V##_fms(V a, V b, V c); \
+\
+_sol_ void V##_scale_n(V* dst, const V* v, T f, size_t n);                  \
+_sol_ void V##_norm_n(V* dst, const V* v, size_t n);                        \
+_sol_ void V##_norm_fast_n(V* dst, const V* v, size_t n);                   \
+_sol_ void V##_mag_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sum_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sq_n(V* dst, const V* v, size_t n);                          \
+_sol_ void V##_add_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_addf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_sub_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_subf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fsub_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_mul_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_mulf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_div_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_divf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fdiv_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_fma_n(V* dst, const V* a, const V* b, const V* c, size_t n); \
+_sol_ void V##_fms_n(V* dst, const V* a, const V* b, const V* c, size_t n);
 
 FX4(f32, f32x4)
 FX4(f64, f64x4)
 
 #undef FX4
 
+#define FX8(T, V) \
+_sol_ V V##_set(T l0, T l1, T l2, T l3, T l4, T l5, T l6, T l7); \
+_sol_ V V##_setf(T f);                                           \
+_sol_ V V##_zero(void);                                          \
+_sol_ V V##_load(const T* p);                                    \
+_sol_ void V##_store(T* p, V v);                                 \
+\
+_sol_ T V##_sum(V v); \
+_sol_ V V##_sq(V v);  \
+\
+_sol_ V V##_add(V a, V b);      \
+_sol_ V V##_addf(V v, T f);     \
+_sol_ V V##_sub(V a, V b);      \
+_sol_ V V##_subf(V v, T f);     \
+_sol_ V V##_fsub(T f, V v);     \
+_sol_ V V##_mul(V a, V b);      \
+_sol_ V V##_mulf(V v, T f);     \
+_sol_ V V##_div(V a, V b);      \
+_sol_ V V##_divf(V v, T f);     \
+_sol_ V V##_fdiv(T f, V v);     \
+_sol_ V V##_fma(V a, V b, V c); \
+_sol_ V V##_fms(V a, V b, V c); \
+\
+_sol_ void V##_sum_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sq_n(V* dst, const V* v, size_t n);                          \
+_sol_ void V##_add_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_addf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_sub_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_subf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fsub_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_mul_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_mulf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_div_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_divf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fdiv_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_fma_n(V* dst, const V* a, const V* b, const V* c, size_t n); \
+_sol_ void V##_fms_n(V* dst, const V* a, const V* b, const V* c, size_t n);
+
+FX8(f32, f32x8)
+FX8(f64, f64x8)
+
+#undef FX8
+
+#define FX16(T, V) \
+_sol_ V V##_set(T l0, T l1, T l2, T l3, T l4, T l5, T l6, T l7,         \
+                 T l8, T l9, T l10, T l11, T l12, T l13, T l14, T l15); \
+_sol_ V V##_setf(T f);                                                  \
+_sol_ V V##_zero(void);                                                 \
+_sol_ V V##_load(const T* p);                                           \
+_sol_ void V##_store(T* p, V v);                                        \
+\
+_sol_ T V##_sum(V v); \
+_sol_ V V##_sq(V v);  \
+\
+_sol_ V V##_add(V a, V b);      \
+_sol_ V V##_addf(V v, T f);     \
+_sol_ V V##_sub(V a, V b);      \
+_sol_ V V##_subf(V v, T f);     \
+_sol_ V V##_fsub(T f, V v);     \
+_sol_ V V##_mul(V a, V b);      \
+_sol_ V V##_mulf(V v, T f);     \
+_sol_ V V##_div(V a, V b);      \
+_sol_ V V##_divf(V v, T f);     \
+_sol_ V V##_fdiv(T f, V v);     \
+_sol_ V V##_fma(V a, V b, V c); \
+_sol_ V V##_fms(V a, V b, V c); \
+\
+_sol_ void V##_sum_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sq_n(V* dst, const V* v, size_t n);                          \
+_sol_ void V##_add_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_addf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_sub_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_subf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fsub_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_mul_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_mulf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_div_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_divf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fdiv_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_fma_n(V* dst, const V* a, const V* b, const V* c, size_t n); \
+_sol_ void V##_fms_n(V* dst, const V* a, const V* b, const V* c, size_t n);
+
+FX16(f32, f32x16)
+FX16(f64, f64x16)
+
+#undef FX16
+
+#define IX1(T) \
+_sol_ T T##_mulhi(T a, T b);
+
+IX1(i8)
+IX1(i16)
+IX1(i32)
+IX1(i64)
+
+#undef IX1
+
 #define IX2(T, V) \
 _sol_ V V##_set(T x, T y); \
 _sol_ V V##_setf(T f);     \
@@ -343,6 +757,21 @@ _sol_ V V##_divf(V v, T f);     \
 _sol_ V V##_fdiv(T f, V v);     \
 _sol_ V V##_fma(V a, V b, V c); \
 _sol_ V V##_fms(V a, V b, V c); \
+\
+_sol_ void V##_sum_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sq_n(V* dst, const V* v, size_t n);                          \
+_sol_ void V##_add_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_addf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_sub_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_subf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fsub_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_mul_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_mulf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_div_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_divf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fdiv_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_fma_n(V* dst, const V* a, const V* b, const V* c, size_t n); \
+_sol_ void V##_fms_n(V* dst, const V* a, const V* b, const V* c, size_t n);
 
 IX2(i8,   i8x2)
 IX2(i16, i16x2)
@@ -371,6 +800,21 @@ _sol_ V V##_divf(V v, T f);     \
 _sol_ V V##_fdiv(T f, V v);     \
 _sol_ V V##_fma(V a, V b, V c); \
 _sol_ V V##_fms(V a, V b, V c); \
+\
+_sol_ void V##_sum_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sq_n(V* dst, const V* v, size_t n);                          \
+_sol_ void V##_add_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_addf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_sub_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_subf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fsub_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_mul_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_mulf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_div_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_divf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fdiv_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_fma_n(V* dst, const V* a, const V* b, const V* c, size_t n); \
+_sol_ void V##_fms_n(V* dst, const V* a, const V* b, const V* c, size_t n);
 
 IX3(i8,   i8x3)
 IX3(i16, i16x3)
@@ -399,6 +843,21 @@ _sol_ V V##_divf(V v, T f);     \
 _sol_ V V##_fdiv(T f, V v);     \
 _sol_ V V##_fma(V a, V b, V c); \
 _sol_ V V##_fms(V a, V b, V c); \
+\
+_sol_ void V##_sum_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sq_n(V* dst, const V* v, size_t n);                          \
+_sol_ void V##_add_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_addf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_sub_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_subf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fsub_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_mul_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_mulf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_div_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_divf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fdiv_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_fma_n(V* dst, const V* a, const V* b, const V* c, size_t n); \
+_sol_ void V##_fms_n(V* dst, const V* a, const V* b, const V* c, size_t n);
 
 IX4(i8,   i8x4)
 IX4(i16, i16x4)
@@ -407,6 +866,107 @@ IX4(i64, i64x4)
 
 #undef IX4
 
+#define IX8(T, V) \
+_sol_ V V##_set(T l0, T l1, T l2, T l3, T l4, T l5, T l6, T l7); \
+_sol_ V V##_setf(T f);                                           \
+_sol_ V V##_zero(void);                                          \
+_sol_ V V##_load(const T* p);                                    \
+_sol_ void V##_store(T* p, V v);                                 \
+\
+_sol_ T V##_sum(V v); \
+_sol_ V V##_sq(V v);  \
+\
+_sol_ V V##_add(V a, V b);      \
+_sol_ V V##_addf(V v, T f);     \
+_sol_ V V##_sub(V a, V b);      \
+_sol_ V V##_subf(V v, T f);     \
+_sol_ V V##_fsub(T f, V v);     \
+_sol_ V V##_mul(V a, V b);      \
+_sol_ V V##_mulf(V v, T f);     \
+_sol_ V V##_div(V a, V b);      \
+_sol_ V V##_divf(V v, T f);     \
+_sol_ V V##_fdiv(T f, V v);     \
+_sol_ V V##_fma(V a, V b, V c); \
+_sol_ V V##_fms(V a, V b, V c); \
+\
+_sol_ void V##_sum_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sq_n(V* dst, const V* v, size_t n);                          \
+_sol_ void V##_add_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_addf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_sub_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_subf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fsub_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_mul_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_mulf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_div_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_divf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fdiv_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_fma_n(V* dst, const V* a, const V* b, const V* c, size_t n); \
+_sol_ void V##_fms_n(V* dst, const V* a, const V* b, const V* c, size_t n);
+
+IX8(i8,   i8x8)
+IX8(i16, i16x8)
+IX8(i32, i32x8)
+IX8(i64, i64x8)
+
+#undef IX8
+
+#define IX16(T, V) \
+_sol_ V V##_set(T l0, T l1, T l2, T l3, T l4, T l5, T l6, T l7,         \
+                 T l8, T l9, T l10, T l11, T l12, T l13, T l14, T l15); \
+_sol_ V V##_setf(T f);                                                  \
+_sol_ V V##_zero(void);                                                 \
+_sol_ V V##_load(const T* p);                                           \
+_sol_ void V##_store(T* p, V v);                                        \
+\
+_sol_ T V##_sum(V v); \
+_sol_ V V##_sq(V v);  \
+\
+_sol_ V V##_add(V a, V b);      \
+_sol_ V V##_addf(V v, T f);     \
+_sol_ V V##_sub(V a, V b);      \
+_sol_ V V##_subf(V v, T f);     \
+_sol_ V V##_fsub(T f, V v);     \
+_sol_ V V##_mul(V a, V b);      \
+_sol_ V V##_mulf(V v, T f);     \
+_sol_ V V##_div(V a, V b);      \
+_sol_ V V##_divf(V v, T f);     \
+_sol_ V V##_fdiv(T f, V v);     \
+_sol_ V V##_fma(V a, V b, V c); \
+_sol_ V V##_fms(V a, V b, V c); \
+\
+_sol_ void V##_sum_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sq_n(V* dst, const V* v, size_t n);                          \
+_sol_ void V##_add_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_addf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_sub_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_subf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fsub_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_mul_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_mulf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_div_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_divf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fdiv_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_fma_n(V* dst, const V* a, const V* b, const V* c, size_t n); \
+_sol_ void V##_fms_n(V* dst, const V* a, const V* b, const V* c, size_t n);
+
+IX16(i8,   i8x16)
+IX16(i16, i16x16)
+IX16(i32, i32x16)
+IX16(i64, i64x16)
+
+#undef IX16
+
+#define UX1(T) \
+_sol_ T T##_mulhi(T a, T b);
+
+UX1(u8)
+UX1(u16)
+UX1(u32)
+UX1(u64)
+
+#undef UX1
+
 #define UX2(T, V) \
 _sol_ V V##_set(T x, T y); \
 _sol_ V V##_setf(T f);     \
@@ -427,6 +987,21 @@ _sol_ V V##_divf(V v, T f);     \
 _sol_ V V##_fdiv(T f, V v);     \
 _sol_ V V##_fma(V a, V b, V c); \
 _sol_ V V##_fms(V a, V b, V c); \
+\
+_sol_ void V##_sum_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sq_n(V* dst, const V* v, size_t n);                          \
+_sol_ void V##_add_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_addf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_sub_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_subf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fsub_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_mul_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_mulf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_div_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_divf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fdiv_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_fma_n(V* dst, const V* a, const V* b, const V* c, size_t n); \
+_sol_ void V##_fms_n(V* dst, const V* a, const V* b, const V* c, size_t n);
 
 UX2(u8,   u8x2)
 UX2(u16, u16x2)
@@ -455,6 +1030,21 @@ _sol_ V V##_divf(V v, T f);     \
 _sol_ V V##_fdiv(T f, V v);     \
 _sol_ V V##_fma(V a, V b, V c); \
 _sol_ V V##_fms(V a, V b, V c); \
+\
+_sol_ void V##_sum_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sq_n(V* dst, const V* v, size_t n);                          \
+_sol_ void V##_add_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_addf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_sub_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_subf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fsub_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_mul_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_mulf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_div_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_divf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fdiv_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_fma_n(V* dst, const V* a, const V* b, const V* c, size_t n); \
+_sol_ void V##_fms_n(V* dst, const V* a, const V* b, const V* c, size_t n);
 
 UX3(u8,   u8x3)
 UX3(u16, u16x3)
@@ -483,6 +1073,21 @@ _sol_ V V##_divf(V v, T f);     \
 _sol_ V V##_fdiv(T f, V v);     \
 _sol_ V V##_fma(V a, V b, V c); \
 _sol_ V V##_fms(V a, V b, V c); \
+\
+_sol_ void V##_sum_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sq_n(V* dst, const V* v, size_t n);                          \
+_sol_ void V##_add_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_addf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_sub_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_subf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fsub_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_mul_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_mulf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_div_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_divf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fdiv_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_fma_n(V* dst, const V* a, const V* b, const V* c, size_t n); \
+_sol_ void V##_fms_n(V* dst, const V* a, const V* b, const V* c, size_t n);
 
 UX4(u8,   u8x4)
 UX4(u16, u16x4)
@@ -491,24 +1096,1226 @@ UX4(u64, u64x4)
 
 #undef UX4
 
+#define UX8(T, V) \
+_sol_ V V##_set(T l0, T l1, T l2, T l3, T l4, T l5, T l6, T l7); \
+_sol_ V V##_setf(T f);                                           \
+_sol_ V V##_zero(void);                                          \
+_sol_ V V##_load(const T* p);                                    \
+_sol_ void V##_store(T* p, V v);                                 \
+\
+_sol_ T V##_sum(V v); \
+_sol_ V V##_sq(V v);  \
+\
+_sol_ V V##_add(V a, V b);      \
+_sol_ V V##_addf(V v, T f);     \
+_sol_ V V##_sub(V a, V b);      \
+_sol_ V V##_subf(V v, T f);     \
+_sol_ V V##_fsub(T f, V v);     \
+_sol_ V V##_mul(V a, V b);      \
+_sol_ V V##_mulf(V v, T f);     \
+_sol_ V V##_div(V a, V b);      \
+_sol_ V V##_divf(V v, T f);     \
+_sol_ V V##_fdiv(T f, V v);     \
+_sol_ V V##_fma(V a, V b, V c); \
+_sol_ V V##_fms(V a, V b, V c); \
+\
+_sol_ void V##_sum_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sq_n(V* dst, const V* v, size_t n);                          \
+_sol_ void V##_add_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_addf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_sub_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_subf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fsub_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_mul_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_mulf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_div_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_divf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fdiv_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_fma_n(V* dst, const V* a, const V* b, const V* c, size_t n); \
+_sol_ void V##_fms_n(V* dst, const V* a, const V* b, const V* c, size_t n);
+
+UX8(u8,   u8x8)
+UX8(u16, u16x8)
+UX8(u32, u32x8)
+UX8(u64, u64x8)
+
+#undef UX8
+
+#define UX16(T, V) \
+_sol_ V V##_set(T l0, T l1, T l2, T l3, T l4, T l5, T l6, T l7,         \
+                 T l8, T l9, T l10, T l11, T l12, T l13, T l14, T l15); \
+_sol_ V V##_setf(T f);                                                  \
+_sol_ V V##_zero(void);                                                 \
+_sol_ V V##_load(const T* p);                                           \
+_sol_ void V##_store(T* p, V v);                                        \
+\
+_sol_ T V##_sum(V v); \
+_sol_ V V##_sq(V v);  \
+\
+_sol_ V V##_add(V a, V b);      \
+_sol_ V V##_addf(V v, T f);     \
+_sol_ V V##_sub(V a, V b);      \
+_sol_ V V##_subf(V v, T f);     \
+_sol_ V V##_fsub(T f, V v);     \
+_sol_ V V##_mul(V a, V b);      \
+_sol_ V V##_mulf(V v, T f);     \
+_sol_ V V##_div(V a, V b);      \
+_sol_ V V##_divf(V v, T f);     \
+_sol_ V V##_fdiv(T f, V v);     \
+_sol_ V V##_fma(V a, V b, V c); \
+_sol_ V V##_fms(V a, V b, V c); \
+\
+_sol_ void V##_sum_n(T* dst, const V* v, size_t n);                         \
+_sol_ void V##_sq_n(V* dst, const V* v, size_t n);                          \
+_sol_ void V##_add_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_addf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_sub_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_subf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fsub_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_mul_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_mulf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_div_n(V* dst, const V* a, const V* b, size_t n);             \
+_sol_ void V##_divf_n(V* dst, const V* v, T f, size_t n);                   \
+_sol_ void V##_fdiv_n(V* dst, T f, const V* v, size_t n);                   \
+_sol_ void V##_fma_n(V* dst, const V* a, const V* b, const V* c, size_t n); \
+_sol_ void V##_fms_n(V* dst, const V* a, const V* b, const V* c, size_t n);
+
+UX16(u8,   u8x16)
+UX16(u16, u16x16)
+UX16(u32, u32x16)
+UX16(u64, u64x16)
+
+#undef UX16
+
+#define FXL(T, L) \
+\
+_sol_ L L##_setf(T f);                         \
+_sol_ L L##_load(const T* p);                  \
+_sol_ L L##_loadn(const T* p, size_t n);       \
+_sol_ void L##_store(T* p, L v);               \
+_sol_ void L##_storen(T* p, L v, size_t n);    \
+_sol_ L L##_sqrt(L v);                         \
+_sol_ L L##_rsqrt(L v);                        \
+_sol_ void T##_rsqrt_n(T* dst, const T* v, size_t n);
+
+FXL(f32, f32l)
+FXL(f64, f64l)
+
+#undef FXL
+
+#define FXM(T, V) \
+\
+_sol_ V V##_sin(V v);                   \
+_sol_ V V##_cos(V v);                   \
+_sol_ V V##_tan(V v);                   \
+_sol_ void V##_sincos(V v, V* s, V* c); \
+_sol_ V V##_asin(V v);                  \
+_sol_ V V##_acos(V v);                  \
+_sol_ V V##_atan(V v);                  \
+_sol_ V V##_atan2(V y, V x);
+
+FXM(f32, f32x4)
+FXM(f64, f64x4)
+FXM(f32, f32l)
+FXM(f64, f64l)
+
+#undef FXM
+
+#define FX2S(T, V, L, S, B) \
+\
+_sol_ S S##_set(T* x, T* y);           \
+_sol_ V S##_at(S s, size_t i);         \
+_sol_ void S##_put(S s, size_t i, V v); \
+\
+_sol_ B B##_load(S s, size_t i);                    \
+_sol_ B B##_loadn(S s, size_t i, size_t n);         \
+_sol_ void B##_store(S s, size_t i, B b);           \
+_sol_ void B##_storen(S s, size_t i, B b, size_t n); \
+\
+_sol_ B B##_rot(B v, T cs, T sn); \
+_sol_ B B##_norm(B v);            \
+_sol_ B B##_norm_fast(B v);       \
+_sol_ L B##_mag(B v);             \
+_sol_ B B##_proj(B a, B b);       \
+_sol_ L B##_angle(B a, B b);      \
+_sol_ L B##_cross(B a, B b);      \
+_sol_ L B##_dot(B a, B b);        \
+\
+_sol_ void S##_rot(S dst, S v, T rad, size_t n);   \
+_sol_ void S##_norm(S dst, S v, size_t n);         \
+_sol_ void S##_norm_fast(S dst, S v, size_t n);    \
+_sol_ void S##_mag(T* dst, S v, size_t n);         \
+_sol_ void S##_proj(S dst, S a, S b, size_t n);    \
+_sol_ void S##_angle(T* dst, S a, S b, size_t n);  \
+_sol_ void S##_cross(T* dst, S a, S b, size_t n);  \
+_sol_ void S##_dot(T* dst, S a, S b, size_t n);
+
+FX2S(f32, f32x2, f32l, f32x2s, f32x2l)
+FX2S(f64, f64x2, f64l, f64x2s, f64x2l)
+
+#undef FX2S
+
+#define FX3S(T, V, L, S, B, Q) \
+\
+_sol_ S S##_set(T* x, T* y, T* z);     \
+_sol_ V S##_at(S s, size_t i);         \
+_sol_ void S##_put(S s, size_t i, V v); \
+\
+_sol_ B B##_load(S s, size_t i);                    \
+_sol_ B B##_loadn(S s, size_t i, size_t n);         \
+_sol_ void B##_store(S s, size_t i, B b);           \
+_sol_ void B##_storen(S s, size_t i, B b, size_t n); \
+\
+_sol_ B B##_rot(B v, Q q);   \
+_sol_ B B##_norm(B v);       \
+_sol_ B B##_norm_fast(B v);  \
+_sol_ L B##_mag(B v);        \
+_sol_ B B##_proj(B a, B b);  \
+_sol_ L B##_angle(B a, B b); \
+_sol_ B B##_cross(B a, B b); \
+_sol_ L B##_dot(B a, B b);   \
+\
+_sol_ void S##_rot(S dst, S v, Q q, size_t n);     \
+_sol_ void S##_norm(S dst, S v, size_t n);         \
+_sol_ void S##_norm_fast(S dst, S v, size_t n);    \
+_sol_ void S##_mag(T* dst, S v, size_t n);         \
+_sol_ void S##_proj(S dst, S a, S b, size_t n);    \
+_sol_ void S##_angle(T* dst, S a, S b, size_t n);  \
+_sol_ void S##_cross(S dst, S a, S b, size_t n);   \
+_sol_ void S##_dot(T* dst, S a, S b, size_t n);
+
+FX3S(f32, f32x3, f32l, f32x3s, f32x3l, f32x4)
+FX3S(f64, f64x3, f64l, f64x3s, f64x3l, f64x4)
+
+#undef FX3S
+
+#define FX3X3(T, V, M) \
+\
+_sol_ M M##_set(V c0, V c1, V c2); \
+_sol_ M M##_id(void);              \
+\
+_sol_ V M##_mulv(M m, V v);  \
+_sol_ M M##_mul(M a, M b);   \
+_sol_ M M##_trans(M m);      \
+_sol_ T M##_det(M m);        \
+_sol_ M M##_inv(M m);
+
+FX3X3(f32, f32x3, f32x3x3)
+FX3X3(f64, f64x3, f64x3x3)
+
+#undef FX3X3
+
+#define FX4X4(T, V, M, V3) \
+\
+_sol_ M M##_set(V c0, V c1, V c2, V c3); \
+_sol_ M M##_id(void);                    \
+\
+_sol_ V M##_mulv(M m, V v);   \
+_sol_ M M##_mul(M a, M b);    \
+_sol_ M M##_trans(M m);       \
+_sol_ T M##_det(M m);         \
+_sol_ M M##_inv(M m);         \
+_sol_ M M##_inv_affine(M m);  \
+_sol_ V3 M##_mulp(M m, V3 p); \
+\
+_sol_ void M##_mulv_n(V* dst, M m, const V* v, size_t n);  \
+_sol_ void M##_mulp_n(V3* dst, M m, const V3* p, size_t n);
+
+FX4X4(f32, f32x4, f32x4x4, f32x3)
+FX4X4(f64, f64x4, f64x4x4, f64x3)
+
+#undef FX4X4
+
+#define FXQ(T, V, V3, M, M3) \
+\
+_sol_ V V##_qid(void);             \
+_sol_ V V##_qaxis(V3 axis, T rad); \
+\
+_sol_ V V##_qmul(V a, V b);        \
+_sol_ V V##_qconj(V q);            \
+_sol_ V V##_qinv(V q);             \
+_sol_ V3 V##_qrot(V q, V3 v);      \
+_sol_ V V##_qnlerp(V a, V b, T t); \
+_sol_ V V##_qslerp(V a, V b, T t); \
+_sol_ M3 V##_qmat3(V q);           \
+_sol_ M V##_qmat(V q);             \
+\
+_sol_ void V##_qmul_n(V* dst, const V* a, const V* b, size_t n);        \
+_sol_ void V##_qconj_n(V* dst, const V* v, size_t n);                   \
+_sol_ void V##_qinv_n(V* dst, const V* v, size_t n);                    \
+_sol_ void V##_qrot_n(V3* dst, const V* a, const V3* b, size_t n);      \
+_sol_ void V##_qnlerp_n(V* dst, const V* a, const V* b, T t, size_t n); \
+_sol_ void V##_qslerp_n(V* dst, const V* a, const V* b, T t, size_t n);
+
+FXQ(f32, f32x4, f32x3, f32x4x4, f32x3x3)
+FXQ(f64, f64x4, f64x3, f64x4x4, f64x3x3)
+
+#undef FXQ
+
+#define FX3P(V, P) \
+\
+_sol_ P V##_pack(V v);   \
+_sol_ V V##_unpack(P p); \
+\
+_sol_ void V##_pack_n(P* dst, const V* v, size_t n);   \
+_sol_ void V##_unpack_n(V* dst, const P* p, size_t n);
+
+FX3P(f32x3, f32x3p)
+FX3P(f64x3, f64x3p)
+
+#undef FX3P
+
+_sol_ f16 f32_to_f16(f32 f);
+_sol_ f32 f16_to_f32(f16 h);
+
+_sol_ void f32_to_f16_n(f16* dst, const f32* f, size_t n);
+_sol_ void f16_to_f32_n(f32* dst, const f16* h, size_t n);
+
+#define HX(V, H) \
+\
+_sol_ H V##_to_f16(V v); \
+_sol_ V H##_to_f32(H h); \
+\
+_sol_ void V##_to_f16_n(H* dst, const V* v, size_t n); \
+_sol_ void H##_to_f32_n(V* dst, const H* h, size_t n);
+
+HX(f32x2, f16x2)
+HX(f32x3, f16x3)
+HX(f32x4, f16x4)
+
+#undef HX
+
+#define CMP(V, M) \
+_sol_ M V##_eq(V a, V b);           \
+_sol_ M V##_ne(V a, V b);           \
+_sol_ M V##_lt(V a, V b);           \
+_sol_ M V##_le(V a, V b);           \
+_sol_ M V##_gt(V a, V b);           \
+_sol_ M V##_ge(V a, V b);           \
+_sol_ V V##_select(M m, V a, V b);  \
+_sol_ V V##_min(V a, V b);          \
+_sol_ V V##_max(V a, V b);          \
+_sol_ V V##_clamp(V v, V lo, V hi); \
+\
+_sol_ void V##_min_n(V* dst, const V* a, const V* b, size_t n); \
+_sol_ void V##_max_n(V* dst, const V* a, const V* b, size_t n); \
+_sol_ void V##_clamp_n(V* dst, const V* v, const V* lo, const V* hi, size_t n);
+
+#define CMP_MASK(M) \
+_sol_ bool M##_any(M m); \
+_sol_ bool M##_all(M m);
+
+CMP(f32x2, i32x2)
+CMP(f32x3, i32x3)
+CMP(f32x4, i32x4)
+CMP(f32x8, i32x8)
+CMP(f32x16, i32x16)
+
+CMP(f64x2, i64x2)
+CMP(f64x3, i64x3)
+CMP(f64x4, i64x4)
+CMP(f64x8, i64x8)
+CMP(f64x16, i64x16)
+
+CMP(i8x2, i8x2)
+CMP(i8x3, i8x3)
+CMP(i8x4, i8x4)
+CMP(i8x8, i8x8)
+CMP(i8x16, i8x16)
+
+CMP(i16x2, i16x2)
+CMP(i16x3, i16x3)
+CMP(i16x4, i16x4)
+CMP(i16x8, i16x8)
+CMP(i16x16, i16x16)
+
+CMP(i32x2, i32x2)
+CMP(i32x3, i32x3)
+CMP(i32x4, i32x4)
+CMP(i32x8, i32x8)
+CMP(i32x16, i32x16)
+
+CMP(i64x2, i64x2)
+CMP(i64x3, i64x3)
+CMP(i64x4, i64x4)
+CMP(i64x8, i64x8)
+CMP(i64x16, i64x16)
+
+CMP(u8x2, i8x2)
+CMP(u8x3, i8x3)
+CMP(u8x4, i8x4)
+CMP(u8x8, i8x8)
+CMP(u8x16, i8x16)
+
+CMP(u16x2, i16x2)
+CMP(u16x3, i16x3)
+CMP(u16x4, i16x4)
+CMP(u16x8, i16x8)
+CMP(u16x16, i16x16)
+
+CMP(u32x2, i32x2)
+CMP(u32x3, i32x3)
+CMP(u32x4, i32x4)
+CMP(u32x8, i32x8)
+CMP(u32x16, i32x16)
+
+CMP(u64x2, i64x2)
+CMP(u64x3, i64x3)
+CMP(u64x4, i64x4)
+CMP(u64x8, i64x8)
+CMP(u64x16, i64x16)
+
+CMP_MASK(i8x2)
+CMP_MASK(i8x3)
+CMP_MASK(i8x4)
+CMP_MASK(i8x8)
+CMP_MASK(i8x16)
+
+CMP_MASK(i16x2)
+CMP_MASK(i16x3)
+CMP_MASK(i16x4)
+CMP_MASK(i16x8)
+CMP_MASK(i16x16)
+
+CMP_MASK(i32x2)
+CMP_MASK(i32x3)
+CMP_MASK(i32x4)
+CMP_MASK(i32x8)
+CMP_MASK(i32x16)
+
+CMP_MASK(i64x2)
+CMP_MASK(i64x3)
+CMP_MASK(i64x4)
+CMP_MASK(i64x8)
+CMP_MASK(i64x16)
+
+#undef CMP
+#undef CMP_MASK
+
+#define SAT(V, VW) \
+_sol_ V V##_adds(V a, V b);         \
+_sol_ V V##_subs(V a, V b);         \
+_sol_ V V##_avg(V a, V b);          \
+_sol_ V V##_mulhi(V a, V b);        \
+_sol_ VW V##_widen(V v);            \
+_sol_ VW V##_mulw(V a, V b);        \
+_sol_ VW V##_maddw(V a, V b, VW c); \
+\
+_sol_ void V##_adds_n(V* dst, const V* a, const V* b, size_t n); \
+_sol_ void V##_subs_n(V* dst, const V* a, const V* b, size_t n); \
+_sol_ void V##_avg_n(V* dst, const V* a, const V* b, size_t n);
+
+#define SAT_MADD(V, VH) \
+_sol_ VH V##_madd(V a, V b);
+
+#define SAT_PACK(V, VN, P) \
+_sol_ VN V##_##P(V v);
+
+SAT(i8x2, i16x2)
+SAT(i8x3, i16x3)
+SAT(i8x4, i16x4)
+SAT(i8x8, i16x8)
+SAT(i8x16, i16x16)
+
+SAT(i16x2, i32x2)
+SAT(i16x3, i32x3)
+SAT(i16x4, i32x4)
+SAT(i16x8, i32x8)
+SAT(i16x16, i32x16)
+
+SAT(u8x2, u16x2)
+SAT(u8x3, u16x3)
+SAT(u8x4, u16x4)
+SAT(u8x8, u16x8)
+SAT(u8x16, u16x16)
+
+SAT(u16x2, u32x2)
+SAT(u16x3, u32x3)
+SAT(u16x4, u32x4)
+SAT(u16x8, u32x8)
+SAT(u16x16, u32x16)
+
+SAT_MADD(i16x4, i32x2)
+SAT_MADD(i16x8, i32x4)
+SAT_MADD(i16x16, i32x8)
+
+SAT_PACK(i16x2, i8x2, packs)
+SAT_PACK(i16x3, i8x3, packs)
+SAT_PACK(i16x4, i8x4, packs)
+SAT_PACK(i16x8, i8x8, packs)
+SAT_PACK(i16x16, i8x16, packs)
+
+SAT_PACK(i16x2, u8x2, packus)
+SAT_PACK(i16x3, u8x3, packus)
+SAT_PACK(i16x4, u8x4, packus)
+SAT_PACK(i16x8, u8x8, packus)
+SAT_PACK(i16x16, u8x16, packus)
+
+SAT_PACK(i32x2, i16x2, packs)
+SAT_PACK(i32x3, i16x3, packs)
+SAT_PACK(i32x4, i16x4, packs)
+SAT_PACK(i32x8, i16x8, packs)
+SAT_PACK(i32x16, i16x16, packs)
+
+SAT_PACK(i32x2, u16x2, packus)
+SAT_PACK(i32x3, u16x3, packus)
+SAT_PACK(i32x4, u16x4, packus)
+SAT_PACK(i32x8, u16x8, packus)
+SAT_PACK(i32x16, u16x16, packus)
+
+#undef SAT
+#undef SAT_MADD
+#undef SAT_PACK
+
+#define BITS(V) \
+_sol_ V V##_and(V a, V b);     \
+_sol_ V V##_or(V a, V b);      \
+_sol_ V V##_xor(V a, V b);     \
+_sol_ V V##_not(V v);          \
+_sol_ V V##_andnot(V a, V b);  \
+_sol_ V V##_shl(V a, V b);     \
+_sol_ V V##_shr(V a, V b);     \
+_sol_ V V##_shlf(V v, int k);  \
+_sol_ V V##_shrf(V v, int k);  \
+_sol_ V V##_rotl(V a, V b);    \
+_sol_ V V##_rotr(V a, V b);    \
+_sol_ V V##_rotlf(V v, int k); \
+_sol_ V V##_rotrf(V v, int k); \
+\
+_sol_ void V##_and_n(V* dst, const V* a, const V* b, size_t n);    \
+_sol_ void V##_or_n(V* dst, const V* a, const V* b, size_t n);     \
+_sol_ void V##_xor_n(V* dst, const V* a, const V* b, size_t n);    \
+_sol_ void V##_not_n(V* dst, const V* v, size_t n);                \
+_sol_ void V##_andnot_n(V* dst, const V* a, const V* b, size_t n); \
+_sol_ void V##_shl_n(V* dst, const V* a, const V* b, size_t n);    \
+_sol_ void V##_shr_n(V* dst, const V* a, const V* b, size_t n);    \
+_sol_ void V##_shlf_n(V* dst, const V* v, int k, size_t n);        \
+_sol_ void V##_shrf_n(V* dst, const V* v, int k, size_t n);        \
+_sol_ void V##_rotl_n(V* dst, const V* a, const V* b, size_t n);   \
+_sol_ void V##_rotr_n(V* dst, const V* a, const V* b, size_t n);   \
+_sol_ void V##_rotlf_n(V* dst, const V* v, int k, size_t n);       \
+_sol_ void V##_rotrf_n(V* dst, const V* v, int k, size_t n);
+
+BITS(i8x2)
+BITS(i8x3)
+BITS(i8x4)
+BITS(i8x8)
+BITS(i8x16)
+
+BITS(i16x2)
+BITS(i16x3)
+BITS(i16x4)
+BITS(i16x8)
+BITS(i16x16)
+
+BITS(i32x2)
+BITS(i32x3)
+BITS(i32x4)
+BITS(i32x8)
+BITS(i32x16)
+
+BITS(i64x2)
+BITS(i64x3)
+BITS(i64x4)
+BITS(i64x8)
+BITS(i64x16)
+
+BITS(u8x2)
+BITS(u8x3)
+BITS(u8x4)
+BITS(u8x8)
+BITS(u8x16)
+
+BITS(u16x2)
+BITS(u16x3)
+BITS(u16x4)
+BITS(u16x8)
+BITS(u16x16)
+
+BITS(u32x2)
+BITS(u32x3)
+BITS(u32x4)
+BITS(u32x8)
+BITS(u32x16)
+
+BITS(u64x2)
+BITS(u64x3)
+BITS(u64x4)
+BITS(u64x8)
+BITS(u64x16)
+
+#undef BITS
+
+/*
+** SWZ_P##W is the lane index parameter list of a `W`-lane shuffle, and
+** SWZ_NAMES##W calls `F(V, name, ...)` for every `W`-letter swizzle name over
+** the first `W` of `xyzw`, followed by the lane index of each letter.
+*/
+
+#define SWZ_P2 int l0, int l1
+#define SWZ_P3 int l0, int l1, int l2
+#define SWZ_P4 int l0, int l1, int l2, int l3
+#define SWZ_P8 SWZ_P4, int l4, int l5, int l6, int l7
+#define SWZ_P16 SWZ_P8, int l8, int l9, int l10, int l11, \
+                int l12, int l13, int l14, int l15
+
+#define SWZ_NAMES2(F, V) \
+  F(V, xx, 0, 0) F(V, xy, 0, 1) F(V, yx, 1, 0) F(V, yy, 1, 1)
+
+#define SWZ_NAMES3_C(F, V, A, I, B, J) \
+  F(V, A##B##x, I, J, 0) F(V, A##B##y, I, J, 1) F(V, A##B##z, I, J, 2)
+#define SWZ_NAMES3_B(F, V, A, I)                                \
+  SWZ_NAMES3_C(F, V, A, I, x, 0) SWZ_NAMES3_C(F, V, A, I, y, 1) \
+  SWZ_NAMES3_C(F, V, A, I, z, 2)
+#define SWZ_NAMES3(F, V) \
+  SWZ_NAMES3_B(F, V, x, 0) SWZ_NAMES3_B(F, V, y, 1) SWZ_NAMES3_B(F, V, z, 2)
+
+#define SWZ_NAMES4_D(F, V, A, I, B, J, C, K)                \
+  F(V, A##B##C##x, I, J, K, 0) F(V, A##B##C##y, I, J, K, 1) \
+  F(V, A##B##C##z, I, J, K, 2) F(V, A##B##C##w, I, J, K, 3)
+#define SWZ_NAMES4_C(F, V, A, I, B, J)                                      \
+  SWZ_NAMES4_D(F, V, A, I, B, J, x, 0) SWZ_NAMES4_D(F, V, A, I, B, J, y, 1) \
+  SWZ_NAMES4_D(F, V, A, I, B, J, z, 2) SWZ_NAMES4_D(F, V, A, I, B, J, w, 3)
+#define SWZ_NAMES4_B(F, V, A, I)                                \
+  SWZ_NAMES4_C(F, V, A, I, x, 0) SWZ_NAMES4_C(F, V, A, I, y, 1) \
+  SWZ_NAMES4_C(F, V, A, I, z, 2) SWZ_NAMES4_C(F, V, A, I, w, 3)
+#define SWZ_NAMES4(F, V)                            \
+  SWZ_NAMES4_B(F, V, x, 0) SWZ_NAMES4_B(F, V, y, 1) \
+  SWZ_NAMES4_B(F, V, z, 2) SWZ_NAMES4_B(F, V, w, 3)
+
+#define SWZ(V, P) \
+_sol_ V V##_shuffle(V v, P);       \
+_sol_ V V##_shuffle2(V a, V b, P); \
+_sol_ V V##_splat(V v, int i);
+
+#define SWZ_NAMED(V, N, ...) \
+_sol_ V V##_##N(V v);
+
+SWZ(f32x2, SWZ_P2)
+SWZ(f32x3, SWZ_P3)
+SWZ(f32x4, SWZ_P4)
+SWZ(f32x8, SWZ_P8)
+SWZ(f32x16, SWZ_P16)
+
+SWZ(f64x2, SWZ_P2)
+SWZ(f64x3, SWZ_P3)
+SWZ(f64x4, SWZ_P4)
+SWZ(f64x8, SWZ_P8)
+SWZ(f64x16, SWZ_P16)
+
+SWZ(i8x2, SWZ_P2)
+SWZ(i8x3, SWZ_P3)
+SWZ(i8x4, SWZ_P4)
+SWZ(i8x8, SWZ_P8)
+SWZ(i8x16, SWZ_P16)
+
+SWZ(i16x2, SWZ_P2)
+SWZ(i16x3, SWZ_P3)
+SWZ(i16x4, SWZ_P4)
+SWZ(i16x8, SWZ_P8)
+SWZ(i16x16, SWZ_P16)
+
+SWZ(i32x2, SWZ_P2)
+SWZ(i32x3, SWZ_P3)
+SWZ(i32x4, SWZ_P4)
+SWZ(i32x8, SWZ_P8)
+SWZ(i32x16, SWZ_P16)
+
+SWZ(i64x2, SWZ_P2)
+SWZ(i64x3, SWZ_P3)
+SWZ(i64x4, SWZ_P4)
+SWZ(i64x8, SWZ_P8)
+SWZ(i64x16, SWZ_P16)
+
+SWZ(u8x2, SWZ_P2)
+SWZ(u8x3, SWZ_P3)
+SWZ(u8x4, SWZ_P4)
+SWZ(u8x8, SWZ_P8)
+SWZ(u8x16, SWZ_P16)
+
+SWZ(u16x2, SWZ_P2)
+SWZ(u16x3, SWZ_P3)
+SWZ(u16x4, SWZ_P4)
+SWZ(u16x8, SWZ_P8)
+SWZ(u16x16, SWZ_P16)
+
+SWZ(u32x2, SWZ_P2)
+SWZ(u32x3, SWZ_P3)
+SWZ(u32x4, SWZ_P4)
+SWZ(u32x8, SWZ_P8)
+SWZ(u32x16, SWZ_P16)
+
+SWZ(u64x2, SWZ_P2)
+SWZ(u64x3, SWZ_P3)
+SWZ(u64x4, SWZ_P4)
+SWZ(u64x8, SWZ_P8)
+SWZ(u64x16, SWZ_P16)
+
+SWZ_NAMES2(SWZ_NAMED, f32x2)
+SWZ_NAMES3(SWZ_NAMED, f32x3)
+SWZ_NAMES4(SWZ_NAMED, f32x4)
+
+SWZ_NAMES2(SWZ_NAMED, f64x2)
+SWZ_NAMES3(SWZ_NAMED, f64x3)
+SWZ_NAMES4(SWZ_NAMED, f64x4)
+
+SWZ_NAMES2(SWZ_NAMED, i8x2)
+SWZ_NAMES3(SWZ_NAMED, i8x3)
+SWZ_NAMES4(SWZ_NAMED, i8x4)
+
+SWZ_NAMES2(SWZ_NAMED, i16x2)
+SWZ_NAMES3(SWZ_NAMED, i16x3)
+SWZ_NAMES4(SWZ_NAMED, i16x4)
+
+SWZ_NAMES2(SWZ_NAMED, i32x2)
+SWZ_NAMES3(SWZ_NAMED, i32x3)
+SWZ_NAMES4(SWZ_NAMED, i32x4)
+
+SWZ_NAMES2(SWZ_NAMED, i64x2)
+SWZ_NAMES3(SWZ_NAMED, i64x3)
+SWZ_NAMES4(SWZ_NAMED, i64x4)
+
+SWZ_NAMES2(SWZ_NAMED, u8x2)
+SWZ_NAMES3(SWZ_NAMED, u8x3)
+SWZ_NAMES4(SWZ_NAMED, u8x4)
+
+SWZ_NAMES2(SWZ_NAMED, u16x2)
+SWZ_NAMES3(SWZ_NAMED, u16x3)
+SWZ_NAMES4(SWZ_NAMED, u16x4)
+
+SWZ_NAMES2(SWZ_NAMED, u32x2)
+SWZ_NAMES3(SWZ_NAMED, u32x3)
+SWZ_NAMES4(SWZ_NAMED, u32x4)
+
+SWZ_NAMES2(SWZ_NAMED, u64x2)
+SWZ_NAMES3(SWZ_NAMED, u64x3)
+SWZ_NAMES4(SWZ_NAMED, u64x4)
+
+#undef SWZ
+#undef SWZ_NAMED
+
+#define DIV(T, D) \
+_sol_ D D##_set(T d);         \
+_sol_ T T##_div_by(T n, D d);
+
+#define DIV_V(V, D) \
+_sol_ V V##_div_by(V v, D d); \
+_sol_ void V##_div_by_n(V* dst, const V* v, D d, size_t n);
+
+#define DIV_MULHI(V) \
+_sol_ V V##_mulhi(V a, V b);
+
+DIV_MULHI(i32x2)
+DIV_MULHI(i32x3)
+DIV_MULHI(i32x4)
+DIV_MULHI(i32x8)
+DIV_MULHI(i32x16)
+
+DIV_MULHI(i64x2)
+DIV_MULHI(i64x3)
+DIV_MULHI(i64x4)
+DIV_MULHI(i64x8)
+DIV_MULHI(i64x16)
+
+DIV_MULHI(u32x2)
+DIV_MULHI(u32x3)
+DIV_MULHI(u32x4)
+DIV_MULHI(u32x8)
+DIV_MULHI(u32x16)
+
+DIV_MULHI(u64x2)
+DIV_MULHI(u64x3)
+DIV_MULHI(u64x4)
+DIV_MULHI(u64x8)
+DIV_MULHI(u64x16)
+
+DIV(i8, i8div)
+DIV(i16, i16div)
+DIV(i32, i32div)
+DIV(i64, i64div)
+
+DIV(u8, u8div)
+DIV(u16, u16div)
+DIV(u32, u32div)
+DIV(u64, u64div)
+
+DIV_V(i8x2, i8div)
+DIV_V(i8x3, i8div)
+DIV_V(i8x4, i8div)
+DIV_V(i8x8, i8div)
+DIV_V(i8x16, i8div)
+
+DIV_V(i16x2, i16div)
+DIV_V(i16x3, i16div)
+DIV_V(i16x4, i16div)
+DIV_V(i16x8, i16div)
+DIV_V(i16x16, i16div)
+
+DIV_V(i32x2, i32div)
+DIV_V(i32x3, i32div)
+DIV_V(i32x4, i32div)
+DIV_V(i32x8, i32div)
+DIV_V(i32x16, i32div)
+
+DIV_V(i64x2, i64div)
+DIV_V(i64x3, i64div)
+DIV_V(i64x4, i64div)
+DIV_V(i64x8, i64div)
+DIV_V(i64x16, i64div)
+
+DIV_V(u8x2, u8div)
+DIV_V(u8x3, u8div)
+DIV_V(u8x4, u8div)
+DIV_V(u8x8, u8div)
+DIV_V(u8x16, u8div)
+
+DIV_V(u16x2, u16div)
+DIV_V(u16x3, u16div)
+DIV_V(u16x4, u16div)
+DIV_V(u16x8, u16div)
+DIV_V(u16x16, u16div)
+
+DIV_V(u32x2, u32div)
+DIV_V(u32x3, u32div)
+DIV_V(u32x4, u32div)
+DIV_V(u32x8, u32div)
+DIV_V(u32x16, u32div)
+
+DIV_V(u64x2, u64div)
+DIV_V(u64x3, u64div)
+DIV_V(u64x4, u64div)
+DIV_V(u64x8, u64div)
+DIV_V(u64x16, u64div)
+
+#undef DIV
+#undef DIV_V
+#undef DIV_MULHI
+
+#define RED(T) \
+_sol_ T T##_sum_n(const T* v, size_t n);             \
+_sol_ T T##_dot_n(const T* a, const T* b, size_t n); \
+_sol_ T T##_min_n(const T* v, size_t n);             \
+_sol_ T T##_max_n(const T* v, size_t n);             \
+_sol_ void T##_minmax_n(T* lo, T* hi, const T* v, size_t n);
+
+#define RED_PRECISE(T) \
+_sol_ T T##_sum_precise_n(const T* v, size_t n); \
+_sol_ T T##_dot_precise_n(const T* a, const T* b, size_t n);
+
+RED(f32)
+RED(f64)
+
+RED(i8)
+RED(i16)
+RED(i32)
+RED(i64)
+
+RED(u8)
+RED(u16)
+RED(u32)
+RED(u64)
+
+RED_PRECISE(f32)
+RED_PRECISE(f64)
+
+#undef RED
+#undef RED_PRECISE
+
+#define POLY(T, V) \
+_sol_ V V##_poly(V x, const T* c, size_t degree); \
+_sol_ void V##_poly_n(V* dst, const V* x, const T* c, size_t degree, size_t n);
+
+POLY(f32, f32)
+POLY(f64, f64)
+
+POLY(f32, f32x2)
+POLY(f32, f32x3)
+POLY(f32, f32x4)
+POLY(f32, f32x8)
+POLY(f32, f32x16)
+
+POLY(f64, f64x2)
+POLY(f64, f64x3)
+POLY(f64, f64x4)
+POLY(f64, f64x8)
+POLY(f64, f64x16)
+
+#undef POLY
+
+#define ILV(T) \
+_sol_ void T##_deinterleave2_n(T* x, T* y, const T* src, size_t n); \
+_sol_ void T##_deinterleave3_n(T* x, T* y, T* z, const T* src, size_t n); \
+_sol_ void T##_deinterleave4_n(T* x, T* y, T* z, T* w, const T* src, size_t n); \
+_sol_ void T##_interleave2_n(T* dst, const T* x, const T* y, size_t n); \
+_sol_ void T##_interleave3_n(T* dst, const T* x, const T* y, const T* z, size_t n); \
+_sol_ void T##_interleave4_n(T* dst, const T* x, const T* y, const T* z, const T* w, size_t n);
+
+ILV(f32)
+ILV(f64)
+
+ILV(i8)
+ILV(i16)
+ILV(i32)
+ILV(i64)
+
+ILV(u8)
+ILV(u16)
+ILV(u32)
+ILV(u64)
+
+#undef ILV
+
+/*
+** Dispatch
+**
+** With SOL_DISPATCH defined, every bulk and stream kernel is compiled once per
+** instruction set level, and each call runs the variant for the level chosen
+** by `sol_level_get`: the best the CPU supports unless `sol_level_set` forced
+** a lower one. `SOL_LEVEL_BASE` is whatever the translation unit itself was
+** compiled for. The chosen level is kept in a static, so it is tracked
+** separately by each translation unit. SOL_KERNEL_R is SOL_KERNEL for kernels
+** that return an `R`, like the array reductions.
+*/
+
+typedef enum {
+  SOL_LEVEL_BASE,
+  SOL_LEVEL_AVX,
+  SOL_LEVEL_AVX2,
+  SOL_LEVEL_AVX512
+} sol_level;
+
+_sol_ sol_level sol_cpu_level(void);
+_sol_ sol_level sol_level_get(void);
+_sol_ sol_level sol_level_set(sol_level level);
+
+/*
+** Threads
+**
+** With SOL_THREADS defined, every `_n` array kernel and every array reduction
+** (`T_minmax_n` included) also gets a `_par_n` form that splits the array over
+** a pthread pool, and `sol_par_for` runs any `f(ctx, lo, hi)` over `[0, n)`
+** the same way. Link with -lpthread.
+*/
+
+#ifdef SOL_THREADS
+  _sol_ int sol_threads_get(void);
+  _sol_ int sol_threads_set(int n);
+  _sol_ size_t sol_chunk_get(size_t n);
+  _sol_ void sol_chunk_set(size_t chunk);
+  _sol_ void sol_par_for(size_t n, void (*f)(void* ctx, size_t lo, size_t hi), void* ctx);
+  _sol_ void PAR_for(size_t n, size_t size, void (*f)(void* ctx, size_t lo, size_t hi), void* ctx);
+#endif
+
+#ifdef SOL_DISPATCH
+  #define SOL_KERNEL(N, P, A, ...)                                        \
+    _sol_ void N##_base P __VA_ARGS__                                     \
+    static inline __attribute__((target("avx")))                          \
+    void N##_avx P __VA_ARGS__                                            \
+    static inline __attribute__((target("avx2,fma")))                     \
+    void N##_avx2 P __VA_ARGS__                                           \
+    static inline __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq"))) \
+    void N##_avx512 P __VA_ARGS__                                         \
+    _sol_ void N P {                                                      \
+      switch (sol_level_get()) {                                          \
+        case SOL_LEVEL_AVX512: N##_avx512 A; break;                       \
+        case SOL_LEVEL_AVX2:   N##_avx2 A;   break;                       \
+        case SOL_LEVEL_AVX:    N##_avx A;    break;                       \
+        default:               N##_base A;   break;                       \
+      }                                                                   \
+    }
+
+  #define SOL_KERNEL_R(R, N, P, A, ...)                                   \
+    _sol_ R N##_base P __VA_ARGS__                                        \
+    static inline __attribute__((target("avx")))                          \
+    R N##_avx P __VA_ARGS__                                               \
+    static inline __attribute__((target("avx2,fma")))                     \
+    R N##_avx2 P __VA_ARGS__                                              \
+    static inline __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq"))) \
+    R N##_avx512 P __VA_ARGS__                                            \
+    _sol_ R N P {                                                         \
+      switch (sol_level_get()) {                                          \
+        case SOL_LEVEL_AVX512: return N##_avx512 A;                       \
+        case SOL_LEVEL_AVX2:   return N##_avx2 A;                         \
+        case SOL_LEVEL_AVX:    return N##_avx A;                          \
+        default:               return N##_base A;                         \
+      }                                                                   \
+    }
+#else
+  #define SOL_KERNEL(N, P, A, ...) _sol_ void N P __VA_ARGS__
+  #define SOL_KERNEL_R(R, N, P, A, ...) _sol_ R N P __VA_ARGS__
+#endif
+
+/*
+** Parallel Definers
+**
+** Each bulk definer ends in one of these, as do the hand-written `_n` kernels
+** whose arguments fit one. Under SOL_THREADS they add `F_par_n`: the same
+** arguments, run by `sol_par_for` on slices of the arrays.
+*/
+
+#ifdef SOL_THREADS
+  #define SOL_PAR_N1(F, R, A)                                         \
+    typedef struct { R* dst; const A* v; } F##_par_ctx;               \
+    static inline void F##_par_run(void* ctx, size_t lo, size_t hi) { \
+      const F##_par_ctx* x = (const F##_par_ctx*) ctx;                \
+      F##_n(x->dst + lo, x->v + lo, hi - lo);                         \
+    }                                                                 \
+    _sol_ void F##_par_n(R* dst, const A* v, size_t n) {              \
+      F##_par_ctx x = {dst, v};                                       \
+      sol_par_for(n, F##_par_run, &x);                                \
+    }
+
+  #define SOL_PAR_N2(F, R, A, B)                                      \
+    typedef struct { R* dst; const A* a; const B* b; } F##_par_ctx;   \
+    static inline void F##_par_run(void* ctx, size_t lo, size_t hi) { \
+      const F##_par_ctx* x = (const F##_par_ctx*) ctx;                \
+      F##_n(x->dst + lo, x->a + lo, x->b + lo, hi - lo);              \
+    }                                                                 \
+    _sol_ void F##_par_n(R* dst, const A* a, const B* b, size_t n) {  \
+      F##_par_ctx x = {dst, a, b};                                    \
+      sol_par_for(n, F##_par_run, &x);                                \
+    }
+
+  #define SOL_PAR_N2F(F, R, A, S)                                     \
+    typedef struct { R* dst; const A* v; S p; } F##_par_ctx;          \
+    static inline void F##_par_run(void* ctx, size_t lo, size_t hi) { \
+      const F##_par_ctx* x = (const F##_par_ctx*) ctx;                \
+      F##_n(x->dst + lo, x->v + lo, x->p, hi - lo);                   \
+    }                                                                 \
+    _sol_ void F##_par_n(R* dst, const A* v, S p, size_t n) {         \
+      F##_par_ctx x = {dst, v, p};                                    \
+      sol_par_for(n, F##_par_run, &x);                                \
+    }
+
+  #define SOL_PAR_NF2(F, R, S, A)                                     \
+    typedef struct { R* dst; S f; const A* v; } F##_par_ctx;          \
+    static inline void F##_par_run(void* ctx, size_t lo, size_t hi) { \
+      const F##_par_ctx* x = (const F##_par_ctx*) ctx;                \
+      F##_n(x->dst + lo, x->f, x->v + lo, hi - lo);                   \
+    }                                                                 \
+    _sol_ void F##_par_n(R* dst, S f, const A* v, size_t n) {         \
+      F##_par_ctx x = {dst, f, v};                                    \
+      sol_par_for(n, F##_par_run, &x);                                \
+    }
+
+  #define SOL_PAR_N3F(F, R, A, S)                                         \
+    typedef struct { R* dst; const A* a; const A* b; S p; } F##_par_ctx;  \
+    static inline void F##_par_run(void* ctx, size_t lo, size_t hi) {     \
+      const F##_par_ctx* x = (const F##_par_ctx*) ctx;                    \
+      F##_n(x->dst + lo, x->a + lo, x->b + lo, x->p, hi - lo);            \
+    }                                                                     \
+    _sol_ void F##_par_n(R* dst, const A* a, const A* b, S p, size_t n) { \
+      F##_par_ctx x = {dst, a, b, p};                                     \
+      sol_par_for(n, F##_par_run, &x);                                    \
+    }
+
+  #define SOL_PAR_N3(F, R, A)                                                    \
+    typedef struct { R* dst; const A* a; const A* b; const A* c; } F##_par_ctx;  \
+    static inline void F##_par_run(void* ctx, size_t lo, size_t hi) {            \
+      const F##_par_ctx* x = (const F##_par_ctx*) ctx;                           \
+      F##_n(x->dst + lo, x->a + lo, x->b + lo, x->c + lo, hi - lo);              \
+    }                                                                            \
+    _sol_ void F##_par_n(R* dst, const A* a, const A* b, const A* c, size_t n) { \
+      F##_par_ctx x = {dst, a, b, c};                                            \
+      sol_par_for(n, F##_par_run, &x);                                           \
+    }
+#else
+  #define SOL_PAR_N1(F, R, A)
+  #define SOL_PAR_N2(F, R, A, B)
+  #define SOL_PAR_N2F(F, R, A, S)
+  #define SOL_PAR_NF2(F, R, S, A)
+  #define SOL_PAR_N3F(F, R, A, S)
+  #define SOL_PAR_N3(F, R, A)
+#endif
+
+/*
+** Bulk Definers
+**
+** These generate the `_n` array kernels from the single-vector functions. The
+** main loop is unrolled by four and computes every result before storing any
+** of them, so the four calls can be scheduled together even when `dst` may
+** alias an input; the tail is then finished one element at a time.
+*/
+
+#define SOL_N1(F, R, A) \
+SOL_KERNEL(F##_n, (R* dst, const A* v, size_t n), (dst, v, n), { \
+  size_t i = 0;                \
+  for (; i + 4 <= n; i += 4) { \
+    const R r0 = F(v[i + 0]);  \
+    const R r1 = F(v[i + 1]);  \
+    const R r2 = F(v[i + 2]);  \
+    const R r3 = F(v[i + 3]);  \
+    dst[i + 0] = r0;           \
+    dst[i + 1] = r1;           \
+    dst[i + 2] = r2;           \
+    dst[i + 3] = r3;           \
+  }                            \
+  for (; i < n; i++)           \
+    dst[i] = F(v[i]);          \
+})                             \
+SOL_PAR_N1(F, R, A)
+
+#define SOL_N2(F, R, A) \
+SOL_KERNEL(F##_n, (R* dst, const A* a, const A* b, size_t n), (dst, a, b, n), { \
+  size_t i = 0;                         \
+  for (; i + 4 <= n; i += 4) {          \
+    const R r0 = F(a[i + 0], b[i + 0]); \
+    const R r1 = F(a[i + 1], b[i + 1]); \
+    const R r2 = F(a[i + 2], b[i + 2]); \
+    const R r3 = F(a[i + 3], b[i + 3]); \
+    dst[i + 0] = r0;                    \
+    dst[i + 1] = r1;                    \
+    dst[i + 2] = r2;                    \
+    dst[i + 3] = r3;                    \
+  }                                     \
+  for (; i < n; i++)                    \
+    dst[i] = F(a[i], b[i]);             \
+})                                      \
+SOL_PAR_N2(F, R, A, A)
+
+#define SOL_N2F(F, R, A, S, P) \
+SOL_KERNEL(F##_n, (R* dst, const A* v, S P, size_t n), (dst, v, P, n), { \
+  size_t i = 0;                  \
+  for (; i + 4 <= n; i += 4) {   \
+    const R r0 = F(v[i + 0], P); \
+    const R r1 = F(v[i + 1], P); \
+    const R r2 = F(v[i + 2], P); \
+    const R r3 = F(v[i + 3], P); \
+    dst[i + 0] = r0;             \
+    dst[i + 1] = r1;             \
+    dst[i + 2] = r2;             \
+    dst[i + 3] = r3;             \
+  }                              \
+  for (; i < n; i++)             \
+    dst[i] = F(v[i], P);         \
+})                               \
+SOL_PAR_N2F(F, R, A, S)
+
+#define SOL_NF2(F, R, S, A) \
+SOL_KERNEL(F##_n, (R* dst, S f, const A* v, size_t n), (dst, f, v, n), { \
+  size_t i = 0;                  \
+  for (; i + 4 <= n; i += 4) {   \
+    const R r0 = F(f, v[i + 0]); \
+    const R r1 = F(f, v[i + 1]); \
+    const R r2 = F(f, v[i + 2]); \
+    const R r3 = F(f, v[i + 3]); \
+    dst[i + 0] = r0;             \
+    dst[i + 1] = r1;             \
+    dst[i + 2] = r2;             \
+    dst[i + 3] = r3;             \
+  }                              \
+  for (; i < n; i++)             \
+    dst[i] = F(f, v[i]);         \
+})                               \
+SOL_PAR_NF2(F, R, S, A)
+
+#define SOL_N3(F, R, A) \
+SOL_KERNEL(F##_n, (R* dst, const A* a, const A* b, const A* c, size_t n), (dst, a, b, c, n), { \
+  size_t i = 0;                                   \
+  for (; i + 4 <= n; i += 4) {                    \
+    const R r0 = F(a[i + 0], b[i + 0], c[i + 0]); \
+    const R r1 = F(a[i + 1], b[i + 1], c[i + 1]); \
+    const R r2 = F(a[i + 2], b[i + 2], c[i + 2]); \
+    const R r3 = F(a[i + 3], b[i + 3], c[i + 3]); \
+    dst[i + 0] = r0;                              \
+    dst[i + 1] = r1;                              \
+    dst[i + 2] = r2;                              \
+    dst[i + 3] = r3;                              \
+  }                                               \
+  for (; i < n; i++)                              \
+    dst[i] = F(a[i], b[i], c[i]);                 \
+})                                                \
+SOL_PAR_N3(F, R, A)
+
 /*
 ** Header Inclusion
 */
 
+#include "h/cpu.h"
+
+#ifdef SOL_THREADS
+  #include "h/par.h"
+#endif
+
+#include "h/mul.h"
+#include "h/fma.h"
+
 #include "h/fx1.h"
 #include "h/fx2.h"
 #include "h/fx3.h"
 #include "h/fx4.h"
+#include "h/fx8.h"
+#include "h/fx16.h"
 
 #include "h/ix1.h"
 #include "h/ix2.h"
 #include "h/ix3.h"
 #include "h/ix4.h"
+#include "h/ix8.h"
+#include "h/ix16.h"
 
 #include "h/ux1.h"
 #include "h/ux2.h"
 #include "h/ux3.h"
 #include "h/ux4.h"
+#include "h/ux8.h"
+#include "h/ux16.h"
+
+#include "h/fxl.h"
+#include "h/fxm.h"
+#include "h/fx2s.h"
+#include "h/fx3s.h"
+#include "h/fx3x3.h"
+#include "h/fx4x4.h"
+#include "h/fxq.h"
+#include "h/fx3p.h"
+#include "h/hx.h"
+#include "h/cmp.h"
+#include "h/sat.h"
+#include "h/bits.h"
+#include "h/swz.h"
+#include "h/div.h"
+#include "h/red.h"
+#include "h/poly.h"
+#include "h/ilv.h"
+
+#undef SOL_N1
+#undef SOL_N2
+#undef SOL_N2F
+#undef SOL_NF2
+#undef SOL_N3
+#undef SOL_KERNEL
+#undef SOL_KERNEL_R
+#undef SOL_PAR_N1
+#undef SOL_PAR_N2
+#undef SOL_PAR_N2F
+#undef SOL_PAR_NF2
+#undef SOL_PAR_N3F
+#undef SOL_PAR_N3
+#undef MUL_i8
+#undef MUL_u8
+#undef MUL_i16
+#undef MUL_u16
+#undef MUL_i32
+#undef MUL_u32
+#undef MUL_i64
+#undef MUL_u64
+#undef MUL_8
+#undef MUL_64
+#undef MUL_128
+#undef MUL_256
+#undef FMA_ON
+#undef FMA_X86
+#undef FMA_V
+#undef FMA_f32
+#undef FMA_f64
+#undef FMA_LANES
+#undef FMA_REG
+#undef FMA_MEM
+#undef FMA_CUT
+#undef FMA_XMM
+#undef FMA_KEEP
+#undef FMA_VREG
 
 /*
 ** Warning Suppression
@@ -0,0 +1,1045 @@
+/*
+** bench.c | The Sol Vector Library | Latency and throughput of the API.
+** https://github.com/davidgarland/sol
+**
+** Every vector type gets its arithmetic, comparison, bit, saturating and
+** division functions timed twice: as a dependent chain of calls, for the
+** latency of one call, and through its `_n` kernel over an array, for the
+** throughput per element. Scalar, trig, matrix, quaternion, half, packed,
+** SoA, widening and reduction functions are timed the same way where the
+** shape allows it, and functions with no kernel are called once per element
+** of an array instead. Under SOL_THREADS every `_par_n` kernel gets a row too.
+**
+** Each result is the best of several samples after a warmup run, on a thread
+** pinned to the CPU it started on (except under SOL_THREADS, where the pool's
+** workers would inherit that one CPU). The output is CSV, or JSON Lines with
+** -j, one row per function and metric; -q drops the CSV header, and any other
+** argument keeps only the functions whose names contain it. `make bench` runs
+** it once per backend into a single file, so two releases can be compared by
+** diffing that file.
+*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef __linux__
+  #include <sched.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+  #define BENCH_TSC 1
+#else
+  #define BENCH_TSC 0
+#endif
+#include "../sol.h"
+
+#ifndef BENCH_BACKEND
+  #if defined(SOL_THREADS)
+    #define BENCH_BACKEND "par"
+  #elif defined(SOL_N_GNU)
+    #define BENCH_BACKEND "n_gnu"
+  #elif defined(__AVX2__)
+    #define BENCH_BACKEND "gnu_avx2"
+  #elif defined(__AVX__)
+    #define BENCH_BACKEND "gnu_avx"
+  #else
+    #define BENCH_BACKEND "gnu"
+  #endif
+#endif
+
+#define N 1024
+#define SAMPLES 7
+#define SAMPLE_NS 2e5
+
+/*
+** Buffers
+**
+** Four arrays big enough for `N` of the widest type. Before a function is
+** timed they are filled with ones of its lane type, which keeps every chain
+** below finite and away from denormals: `v * 1`, `v / 1`, `1 - v` and friends
+** never leave a small set of values, and the integer ones never divide by
+** zero.
+*/
+
+#define BENCH_BUF static unsigned char __attribute__((aligned(128)))
+
+BENCH_BUF A[N * 128];
+BENCH_BUF B[N * 128];
+BENCH_BUF C[N * 128];
+BENCH_BUF D[N * 128];
+static volatile size_t bench_n = N;
+static volatile size_t bench_big = N * 128;
+static volatile unsigned char sink_byte;
+
+/*
+** The coefficients for `poly` sum to one, so it maps 1 to 1 as well.
+*/
+
+static const f32 coef_f32[] = {0.5f, 0.25f, 0.125f, 0.0625f, 0.0625f};
+static const f64 coef_f64[] = {0.5, 0.25, 0.125, 0.0625, 0.0625};
+
+/*
+** HIDE makes `X` unknown to the optimizer from that point on, which would
+** otherwise turn `v * 1` into `v`, or a chain of `v + b` into `v + n * b`, and
+** time nothing. In a latency loop it goes on the arguments that are not part
+** of the chain, so the reload it costs stays off the critical path.
+*/
+
+#define HIDE(X) __asm__ __volatile__("" : "+m"(X))
+
+static void sink(const void* p, size_t s) {
+  unsigned char x = 0;
+  for (size_t i = 0; i < s; i++)
+    x ^= ((const unsigned char*) p)[i];
+  sink_byte = x;
+}
+
+#define FILL(T)                                      \
+static void fill_##T(void) {                         \
+  for (size_t i = 0; i < sizeof A / sizeof(T); i++)  \
+    ((T*) A)[i] = ((T*) B)[i] = ((T*) C)[i] = (T) 1; \
+}
+
+FILL(f32) FILL(f64)
+FILL(i8) FILL(i16) FILL(i32) FILL(i64)
+FILL(u8) FILL(u16) FILL(u32) FILL(u64)
+
+/*
+** Shapes
+**
+** `X(S, T, V, R, F, P, Q)` names one thing to time: `F` with shape `S`, lane
+** type `T`, argument type `V` and result type `R`. `P` and `Q` are the type
+** and value of a scalar argument for the shapes that take one, the matrix
+** type for NM, and `_` otherwise.
+**
+** - N1, N2, N2F, NF2 and N3 time `F_n` per element, matching the bulk
+**   definers of the same names; NM is the matrix-times-array form and NQ the
+**   quaternion `lerp` form. N2P is N2 with a second array of type `P`, for
+**   `qrot`, and NP times `poly_n` with the degree `Q` of type `P`, over
+**   `coef_T`.
+** - L1, L2, L2F, LF2 and L3 time `v = F(v, ...)` per call, LQ is
+**   `v = F(v, b, q)`, LSEL is `v = F(m, v, b)` for `select` and LP is
+**   `v = F(v, coef_T, q)` for `poly`. LSH and LSH2 are `v = F(v, Q)` and
+**   `v = F(v, b, Q)` for the shuffles, where `Q` is a parenthesized list of
+**   constant lane indices: REV_W reverses `W` lanes and LO_W interleaves the
+**   low halves of two vectors.
+** - LM and LM1 time `m = F(m, id)` and `m = F(m)` on matrices.
+** - S1, S2 and S3 time `F` per element over an array, for functions with no
+**   kernel; the third argument of S3 has type `P`. S2F is S2 with the scalar
+**   `Q` second, SSH is S1 with the lane indices `Q` as for LSH, SEL is S3
+**   with the mask first, and SC is `sincos` writing its two results to `D`.
+** - R1 and R2 time the array reductions per element, and MM `minmax`.
+** - D2, D3 and D4 time `F_n` per tuple for the deinterleave kernels, from `A`
+**   into streams `N * 16` bytes apart in `D`; I2, I3 and I4 go back from `A`.
+** - A1, A2 and A2F time the SoA kernels per element, with every stream of
+**   `V` (and of `R`) `N * 16` bytes apart.
+**
+** Under SOL_THREADS, the shapes that time `F_n` also time `F_par_n` per
+** element over as much of the buffers as fits rather than `N` elements: all
+** of `A` for the wider of `V` and `R`, or whole streams for D2 to I4. main
+** sets a chunk size of CHUNK elements, so even the widest type is shared out.
+*/
+
+#define AT(P, T, K) ((T*) (void*) ((P) + (K) * N * 16))
+#define WIDE(V, R) (sizeof(V) > sizeof(R) ? sizeof(V) : sizeof(R))
+#define BIG(V, R) (N * 128 / WIDE(V, R))
+#define STREAM(T) (N * 16 / sizeof(T))
+#define CHUNK 256
+
+#ifdef SOL_THREADS
+  #define PAR(...) __VA_ARGS__
+#else
+  #define PAR(...)
+#endif
+
+#define SOA_f32(P) AT(P, f32, 0)
+#define SOA_f64(P) AT(P, f64, 0)
+#define SOA_f32x2s(P) f32x2s_set(AT(P, f32, 0), AT(P, f32, 1))
+#define SOA_f64x2s(P) f64x2s_set(AT(P, f64, 0), AT(P, f64, 1))
+#define SOA_f32x3s(P) f32x3s_set(AT(P, f32, 0), AT(P, f32, 1), AT(P, f32, 2))
+#define SOA_f64x3s(P) f64x3s_set(AT(P, f64, 0), AT(P, f64, 1), AT(P, f64, 2))
+
+#define RUN_N1(TP, F, CNT, V, R)                        \
+static void TP(size_t reps) {                           \
+  for (size_t r = 0; r < reps; r++)                     \
+    F((R*) (void*) D, (const V*) (const void*) A, CNT); \
+}
+
+#define RUN_N2(TP, F, CNT, V, R)                  \
+static void TP(size_t reps) {                     \
+  for (size_t r = 0; r < reps; r++)               \
+    F((R*) (void*) D, (const V*) (const void*) A, \
+      (const V*) (const void*) B, CNT);           \
+}
+
+#define RUN_N2F(TP, F, CNT, V, R, P, Q)                    \
+static void TP(size_t reps) {                              \
+  P s = Q;                                                 \
+  HIDE(s);                                                 \
+  for (size_t r = 0; r < reps; r++)                        \
+    F((R*) (void*) D, (const V*) (const void*) A, s, CNT); \
+}
+
+#define RUN_NF2(TP, F, CNT, V, R, P, Q)                    \
+static void TP(size_t reps) {                              \
+  P s = Q;                                                 \
+  HIDE(s);                                                 \
+  for (size_t r = 0; r < reps; r++)                        \
+    F((R*) (void*) D, s, (const V*) (const void*) A, CNT); \
+}
+
+#define RUN_N2P(TP, F, CNT, V, R, P)               \
+static void TP(size_t reps) {                     \
+  for (size_t r = 0; r < reps; r++)               \
+    F((R*) (void*) D, (const V*) (const void*) A, \
+      (const P*) (const void*) B, CNT);           \
+}
+
+#define RUN_N3(TP, F, CNT, V, R)                  \
+static void TP(size_t reps) {                     \
+  for (size_t r = 0; r < reps; r++)               \
+    F((R*) (void*) D, (const V*) (const void*) A, \
+      (const V*) (const void*) B,                 \
+      (const V*) (const void*) C, CNT);           \
+}
+
+#define RUN_NP(TP, F, CNT, T, V, R, P, Q)                   \
+static void TP(size_t reps) {                               \
+  P s = Q;                                                  \
+  HIDE(s);                                                  \
+  for (size_t r = 0; r < reps; r++)                         \
+    F((R*) (void*) D, (const V*) (const void*) A, coef_##T, \
+      s, CNT);                                              \
+}
+
+#define DEF_N1(T, V, R, F, P, Q)       \
+  RUN_N1(tp_##F, F##_n, bench_n, V, R) \
+  PAR(RUN_N1(tpp_##F, F##_par_n, bench_big / WIDE(V, R), V, R))
+
+#define DEF_N2(T, V, R, F, P, Q)       \
+  RUN_N2(tp_##F, F##_n, bench_n, V, R) \
+  PAR(RUN_N2(tpp_##F, F##_par_n, bench_big / WIDE(V, R), V, R))
+
+#define DEF_N2F(T, V, R, F, P, Q)             \
+  RUN_N2F(tp_##F, F##_n, bench_n, V, R, P, Q) \
+  PAR(RUN_N2F(tpp_##F, F##_par_n, bench_big / WIDE(V, R), V, R, P, Q))
+
+#define DEF_NF2(T, V, R, F, P, Q)             \
+  RUN_NF2(tp_##F, F##_n, bench_n, V, R, P, Q) \
+  PAR(RUN_NF2(tpp_##F, F##_par_n, bench_big / WIDE(V, R), V, R, P, Q))
+
+#define DEF_N2P(T, V, R, F, P, Q)          \
+  RUN_N2P(tp_##F, F##_n, bench_n, V, R, P) \
+  PAR(RUN_N2P(tpp_##F, F##_par_n, bench_big / WIDE(V, R), V, R, P))
+
+#define DEF_N3(T, V, R, F, P, Q)       \
+  RUN_N3(tp_##F, F##_n, bench_n, V, R) \
+  PAR(RUN_N3(tpp_##F, F##_par_n, bench_big / WIDE(V, R), V, R))
+
+#define DEF_NP(T, V, R, F, P, Q)                \
+  RUN_NP(tp_##F, F##_n, bench_n, T, V, R, P, Q) \
+  PAR(RUN_NP(tpp_##F, F##_par_n, bench_big / WIDE(V, R), T, V, R, P, Q))
+
+#define RUN_NM(TP, F, CNT, V, R, P)                        \
+static void TP(size_t reps) {                              \
+  const P m = P##_id();                                    \
+  for (size_t r = 0; r < reps; r++)                        \
+    F((R*) (void*) D, m, (const V*) (const void*) A, CNT); \
+}
+
+#define RUN_NQ(TP, F, CNT, V, R, P, Q)            \
+static void TP(size_t reps) {                     \
+  P s = Q;                                        \
+  HIDE(s);                                        \
+  for (size_t r = 0; r < reps; r++)               \
+    F((R*) (void*) D, (const V*) (const void*) A, \
+      (const V*) (const void*) B, s, CNT);        \
+}
+
+#define DEF_NM(T, V, R, F, P, Q)          \
+  RUN_NM(tp_##F, F##_n, bench_n, V, R, P) \
+  PAR(RUN_NM(tpp_##F, F##_par_n, bench_big / WIDE(V, R), V, R, P))
+
+#define DEF_NQ(T, V, R, F, P, Q)             \
+  RUN_NQ(tp_##F, F##_n, bench_n, V, R, P, Q) \
+  PAR(RUN_NQ(tpp_##F, F##_par_n, bench_big / WIDE(V, R), V, R, P, Q))
+
+#define DEF_L1(T, V, R, F, P, Q)    \
+static void lat_##F(size_t reps) {  \
+  V v;                              \
+  memcpy(&v, A, sizeof v);          \
+  for (size_t r = 0; r < reps; r++) \
+    v = F(v);                       \
+  sink(&v, sizeof v);               \
+}
+
+#define DEF_L2(T, V, R, F, P, Q)    \
+static void lat_##F(size_t reps) {  \
+  V v, b;                           \
+  memcpy(&v, A, sizeof v);          \
+  memcpy(&b, B, sizeof b);          \
+  for (size_t r = 0; r < reps; r++) \
+    { HIDE(b); v = F(v, b); }       \
+  sink(&v, sizeof v);               \
+}
+
+#define DEF_L2F(T, V, R, F, P, Q)   \
+static void lat_##F(size_t reps) {  \
+  P s = Q;                          \
+  V v;                              \
+  memcpy(&v, A, sizeof v);          \
+  for (size_t r = 0; r < reps; r++) \
+    { HIDE(s); v = F(v, s); }       \
+  sink(&v, sizeof v);               \
+}
+
+#define DEF_LF2(T, V, R, F, P, Q)   \
+static void lat_##F(size_t reps) {  \
+  P s = Q;                          \
+  V v;                              \
+  memcpy(&v, A, sizeof v);          \
+  for (size_t r = 0; r < reps; r++) \
+    { HIDE(s); v = F(s, v); }       \
+  sink(&v, sizeof v);               \
+}
+
+#define DEF_L3(T, V, R, F, P, Q)          \
+static void lat_##F(size_t reps) {        \
+  V v, b, c;                              \
+  memcpy(&v, A, sizeof v);                \
+  memcpy(&b, B, sizeof b);                \
+  memcpy(&c, C, sizeof c);                \
+  for (size_t r = 0; r < reps; r++)       \
+    { HIDE(b); HIDE(c); v = F(v, b, c); } \
+  sink(&v, sizeof v);                     \
+}
+
+#define DEF_LQ(T, V, R, F, P, Q)          \
+static void lat_##F(size_t reps) {        \
+  P s = Q;                                \
+  V v, b;                                 \
+  memcpy(&v, A, sizeof v);                \
+  memcpy(&b, B, sizeof b);                \
+  for (size_t r = 0; r < reps; r++)       \
+    { HIDE(b); HIDE(s); v = F(v, b, s); } \
+  sink(&v, sizeof v);                     \
+}
+
+#define DEF_LP(T, V, R, F, P, Q)        \
+static void lat_##F(size_t reps) {      \
+  P s = Q;                              \
+  V v;                                  \
+  memcpy(&v, A, sizeof v);              \
+  for (size_t r = 0; r < reps; r++)     \
+    { HIDE(s); v = F(v, coef_##T, s); } \
+  sink(&v, sizeof v);                   \
+}
+
+#define LANES(...) __VA_ARGS__
+
+#define DEF_LSH(T, V, R, F, P, Q)   \
+static void lat_##F(size_t reps) {  \
+  V v;                              \
+  memcpy(&v, A, sizeof v);          \
+  for (size_t r = 0; r < reps; r++) \
+    v = F(v, LANES Q);              \
+  sink(&v, sizeof v);               \
+}
+
+#define DEF_LSH2(T, V, R, F, P, Q)     \
+static void lat_##F(size_t reps) {     \
+  V v, b;                              \
+  memcpy(&v, A, sizeof v);             \
+  memcpy(&b, B, sizeof b);             \
+  for (size_t r = 0; r < reps; r++)    \
+    { HIDE(b); v = F(v, b, LANES Q); } \
+  sink(&v, sizeof v);                  \
+}
+
+#define DEF_LSEL(T, V, R, F, P, Q)        \
+static void lat_##F(size_t reps) {        \
+  P m;                                    \
+  V v, b;                                 \
+  memcpy(&m, C, sizeof m);                \
+  memcpy(&v, A, sizeof v);                \
+  memcpy(&b, B, sizeof b);                \
+  for (size_t r = 0; r < reps; r++)       \
+    { HIDE(m); HIDE(b); v = F(m, v, b); } \
+  sink(&v, sizeof v);                     \
+}
+
+#define DEF_LM(T, V, R, F, P, Q)    \
+static void lat_##F(size_t reps) {  \
+  V id = V##_id(), m = id;          \
+  HIDE(m);                          \
+  for (size_t r = 0; r < reps; r++) \
+    { HIDE(id); m = F(m, id); }     \
+  sink(&m, sizeof m);               \
+}
+
+#define DEF_LM1(T, V, R, F, P, Q)   \
+static void lat_##F(size_t reps) {  \
+  V m = V##_id();                   \
+  HIDE(m);                          \
+  for (size_t r = 0; r < reps; r++) \
+    m = F(m);                       \
+  sink(&m, sizeof m);               \
+}
+
+#define DEF_S1(T, V, R, F, P, Q)           \
+static void tp1_##F(size_t reps) {         \
+  const V* a = (const V*) (const void*) A; \
+  R* d = (R*) (void*) D;                   \
+  for (size_t r = 0; r < reps; r++)        \
+    for (size_t i = 0; i < N; i++)         \
+      d[i] = F(a[i]);                      \
+}
+
+#define DEF_S2(T, V, R, F, P, Q)           \
+static void tp1_##F(size_t reps) {         \
+  const V* a = (const V*) (const void*) A; \
+  const V* b = (const V*) (const void*) B; \
+  R* d = (R*) (void*) D;                   \
+  for (size_t r = 0; r < reps; r++)        \
+    for (size_t i = 0; i < N; i++)         \
+      d[i] = F(a[i], b[i]);                \
+}
+
+#define DEF_S2F(T, V, R, F, P, Q)          \
+static void tp1_##F(size_t reps) {         \
+  P s = Q;                                 \
+  const V* a = (const V*) (const void*) A; \
+  R* d = (R*) (void*) D;                   \
+  HIDE(s);                                 \
+  for (size_t r = 0; r < reps; r++)        \
+    for (size_t i = 0; i < N; i++)         \
+      d[i] = F(a[i], s);                   \
+}
+
+#define DEF_SSH(T, V, R, F, P, Q)          \
+static void tp1_##F(size_t reps) {         \
+  const V* a = (const V*) (const void*) A; \
+  R* d = (R*) (void*) D;                   \
+  for (size_t r = 0; r < reps; r++)        \
+    for (size_t i = 0; i < N; i++)         \
+      d[i] = F(a[i], LANES Q);             \
+}
+
+#define DEF_S3(T, V, R, F, P, Q)           \
+static void tp1_##F(size_t reps) {         \
+  const V* a = (const V*) (const void*) A; \
+  const V* b = (const V*) (const void*) B; \
+  const P* c = (const P*) (const void*) C; \
+  R* d = (R*) (void*) D;                   \
+  for (size_t r = 0; r < reps; r++)        \
+    for (size_t i = 0; i < N; i++)         \
+      d[i] = F(a[i], b[i], c[i]);          \
+}
+
+#define DEF_SEL(T, V, R, F, P, Q)          \
+static void tp1_##F(size_t reps) {         \
+  const P* m = (const P*) (const void*) C; \
+  const V* a = (const V*) (const void*) A; \
+  const V* b = (const V*) (const void*) B; \
+  R* d = (R*) (void*) D;                   \
+  for (size_t r = 0; r < reps; r++)        \
+    for (size_t i = 0; i < N; i++)         \
+      d[i] = F(m[i], a[i], b[i]);          \
+}
+
+#define DEF_SC(T, V, R, F, P, Q)           \
+static void tp1_##F(size_t reps) {         \
+  const V* a = (const V*) (const void*) A; \
+  R* d = (R*) (void*) D;                   \
+  for (size_t r = 0; r < reps; r++)        \
+    for (size_t i = 0; i < N; i++)         \
+      F(a[i], &d[i], &d[N + i]);           \
+}
+
+#define RUN_R1(TP, F, CNT, T, R)             \
+static void TP(size_t reps) {                \
+  R s = 0;                                   \
+  for (size_t r = 0; r < reps; r++)          \
+    s += F((const T*) (const void*) A, CNT); \
+  sink(&s, sizeof s);                        \
+}
+
+#define RUN_R2(TP, F, CNT, T, R)             \
+static void TP(size_t reps) {                \
+  R s = 0;                                   \
+  for (size_t r = 0; r < reps; r++)          \
+    s += F((const T*) (const void*) A,       \
+           (const T*) (const void*) B, CNT); \
+  sink(&s, sizeof s);                        \
+}
+
+#define DEF_R1(T, V, R, F, P, Q)       \
+  RUN_R1(tp_##F, F##_n, bench_n, T, R) \
+  PAR(RUN_R1(tpp_##F, F##_par_n, bench_big / sizeof(T), T, R))
+
+#define DEF_R2(T, V, R, F, P, Q)       \
+  RUN_R2(tp_##F, F##_n, bench_n, T, R) \
+  PAR(RUN_R2(tpp_##F, F##_par_n, bench_big / sizeof(T), T, R))
+
+#define RUN_MM(TP, F, CNT, T, R)                  \
+static void TP(size_t reps) {                     \
+  R s = 0, lo, hi;                                \
+  for (size_t r = 0; r < reps; r++) {             \
+    F(&lo, &hi, (const T*) (const void*) A, CNT); \
+    s += lo;                                      \
+    s += hi;                                      \
+  }                                               \
+  sink(&s, sizeof s);                             \
+}
+
+#define DEF_MM(T, V, R, F, P, Q)       \
+  RUN_MM(tp_##F, F##_n, bench_n, T, R) \
+  PAR(RUN_MM(tpp_##F, F##_par_n, bench_big / sizeof(T), T, R))
+
+#define DEF_A1(T, V, R, F, P, Q)        \
+static void tp_##F(size_t reps) {       \
+  for (size_t r = 0; r < reps; r++)     \
+    F(SOA_##R(D), SOA_##V(A), bench_n); \
+}
+
+#define DEF_A2(T, V, R, F, P, Q)                    \
+static void tp_##F(size_t reps) {                   \
+  for (size_t r = 0; r < reps; r++)                 \
+    F(SOA_##R(D), SOA_##V(A), SOA_##V(B), bench_n); \
+}
+
+#define DEF_A2F(T, V, R, F, P, Q)          \
+static void tp_##F(size_t reps) {          \
+  P s = Q;                                 \
+  HIDE(s);                                 \
+  for (size_t r = 0; r < reps; r++)        \
+    F(SOA_##R(D), SOA_##V(A), s, bench_n); \
+}
+
+#define RUN_D2(TP, F, CNT, T)                                     \
+static void TP(size_t reps) {                                     \
+  for (size_t r = 0; r < reps; r++)                               \
+    F(AT(D, T, 0), AT(D, T, 1), (const T*) (const void*) A, CNT); \
+}
+
+#define RUN_D3(TP, F, CNT, T)                \
+static void TP(size_t reps) {                \
+  for (size_t r = 0; r < reps; r++)          \
+    F(AT(D, T, 0), AT(D, T, 1), AT(D, T, 2), \
+      (const T*) (const void*) A, CNT);      \
+}
+
+#define RUN_D4(TP, F, CNT, T)                             \
+static void TP(size_t reps) {                             \
+  for (size_t r = 0; r < reps; r++)                       \
+    F(AT(D, T, 0), AT(D, T, 1), AT(D, T, 2), AT(D, T, 3), \
+      (const T*) (const void*) A, CNT);                   \
+}
+
+#define RUN_I2(TP, F, CNT, T)                                     \
+static void TP(size_t reps) {                                     \
+  for (size_t r = 0; r < reps; r++)                               \
+    F((T*) (void*) D, AT(A, const T, 0), AT(A, const T, 1), CNT); \
+}
+
+#define RUN_I3(TP, F, CNT, T)                               \
+static void TP(size_t reps) {                               \
+  for (size_t r = 0; r < reps; r++)                         \
+    F((T*) (void*) D, AT(A, const T, 0), AT(A, const T, 1), \
+      AT(A, const T, 2), CNT);                              \
+}
+
+#define RUN_I4(TP, F, CNT, T)                               \
+static void TP(size_t reps) {                               \
+  for (size_t r = 0; r < reps; r++)                         \
+    F((T*) (void*) D, AT(A, const T, 0), AT(A, const T, 1), \
+      AT(A, const T, 2), AT(A, const T, 3), CNT);           \
+}
+
+#define DEF_ILV(K, T, F)             \
+  RUN_##K(tp_##F, F##_n, bench_n, T) \
+  PAR(RUN_##K(tpp_##F, F##_par_n, bench_big / 8 / sizeof(T), T))
+
+#define DEF_D2(T, V, R, F, P, Q) DEF_ILV(D2, T, F)
+#define DEF_D3(T, V, R, F, P, Q) DEF_ILV(D3, T, F)
+#define DEF_D4(T, V, R, F, P, Q) DEF_ILV(D4, T, F)
+#define DEF_I2(T, V, R, F, P, Q) DEF_ILV(I2, T, F)
+#define DEF_I3(T, V, R, F, P, Q) DEF_ILV(I3, T, F)
+#define DEF_I4(T, V, R, F, P, Q) DEF_ILV(I4, T, F)
+
+#define ROW_TP(T, F, PER) {#F "_n", "tput", fill_##T, tp_##F, N}, \
+  PAR({#F "_par_n", "tput", fill_##T, tpp_##F, PER},)
+#define ROW_N1(T, V, R, F, P, Q) ROW_TP(T, F, BIG(V, R))
+#define ROW_N2 ROW_N1
+#define ROW_N2F ROW_N1
+#define ROW_NF2 ROW_N1
+#define ROW_N2P ROW_N1
+#define ROW_N3 ROW_N1
+#define ROW_NP ROW_N1
+#define ROW_NM ROW_N1
+#define ROW_NQ ROW_N1
+#define ROW_R1(T, V, R, F, P, Q) ROW_TP(T, F, BIG(T, T))
+#define ROW_R2 ROW_R1
+#define ROW_MM ROW_R1
+#define ROW_D2(T, V, R, F, P, Q) ROW_TP(T, F, STREAM(T))
+#define ROW_D3 ROW_D2
+#define ROW_D4 ROW_D2
+#define ROW_I2 ROW_D2
+#define ROW_I3 ROW_D2
+#define ROW_I4 ROW_D2
+#define ROW_L1(T, V, R, F, P, Q) {#F, "lat", fill_##T, lat_##F, 1},
+#define ROW_L2 ROW_L1
+#define ROW_L2F ROW_L1
+#define ROW_LF2 ROW_L1
+#define ROW_L3 ROW_L1
+#define ROW_LQ ROW_L1
+#define ROW_LSEL ROW_L1
+#define ROW_LP ROW_L1
+#define ROW_LSH ROW_L1
+#define ROW_LSH2 ROW_L1
+#define ROW_LM ROW_L1
+#define ROW_LM1 ROW_L1
+#define ROW_S1(T, V, R, F, P, Q) {#F, "tput", fill_##T, tp1_##F, N},
+#define ROW_S2 ROW_S1
+#define ROW_S2F ROW_S1
+#define ROW_SSH ROW_S1
+#define ROW_S3 ROW_S1
+#define ROW_SEL ROW_S1
+#define ROW_SC ROW_S1
+#define ROW_A1(T, V, R, F, P, Q) {#F, "tput", fill_##T, tp_##F, N},
+#define ROW_A2 ROW_A1
+#define ROW_A2F ROW_A1
+
+#define DEF(S, T, V, R, F, P, Q) DEF_##S(T, V, R, F, P, Q)
+#define ROW(S, T, V, R, F, P, Q) ROW_##S(T, V, R, F, P, Q)
+
+/*
+** Families
+**
+** Each function of a vector type that maps `V` to `V` gets both a latency and
+** a throughput row; the ones that return a scalar only have the latter, and so
+** do `not`, `qconj` and `splat`, since a chain of any of them folds away. So
+** do the ones that return another type, like the comparisons and the widening
+** math, and the inverse trig functions, whose chains leave their domain. The
+** shuffles and named swizzles only have the former: over an array they would
+** time little but the loads and stores.
+*/
+
+#define B1(X, T, V, F) X(N1, T, V, V, F, _, _) X(L1, T, V, V, F, _, _)
+#define B2(X, T, V, F) X(N2, T, V, V, F, _, _) X(L2, T, V, V, F, _, _)
+#define B3(X, T, V, F) X(N3, T, V, V, F, _, _) X(L3, T, V, V, F, _, _)
+#define B2F(X, T, V, F, P, Q) X(N2F, T, V, V, F, P, Q) X(L2F, T, V, V, F, P, Q)
+#define BF2(X, T, V, F, P, Q) X(NF2, T, V, V, F, P, Q) X(LF2, T, V, V, F, P, Q)
+
+#define ARITH(X, T, V)             \
+  X(N1, T, V, T, V##_sum, _, _)    \
+  B1(X, T, V, V##_sq)              \
+  B2(X, T, V, V##_add)             \
+  B2F(X, T, V, V##_addf, T, (T) 1) \
+  B2(X, T, V, V##_sub)             \
+  B2F(X, T, V, V##_subf, T, (T) 1) \
+  BF2(X, T, V, V##_fsub, T, (T) 1) \
+  B2(X, T, V, V##_mul)             \
+  B2F(X, T, V, V##_mulf, T, (T) 1) \
+  B2(X, T, V, V##_div)             \
+  B2F(X, T, V, V##_divf, T, (T) 1) \
+  BF2(X, T, V, V##_fdiv, T, (T) 1) \
+  B3(X, T, V, V##_fma)             \
+  B3(X, T, V, V##_fms)             \
+  B2(X, T, V, V##_min)             \
+  B2(X, T, V, V##_max)             \
+  B3(X, T, V, V##_clamp)
+
+#define GEO(X, T, V)                \
+  B2F(X, T, V, V##_scale, T, (T) 1) \
+  B1(X, T, V, V##_norm)             \
+  B1(X, T, V, V##_norm_fast)        \
+  X(N1, T, V, T, V##_mag, _, _)
+
+#define GEO23(X, T, V)            \
+  GEO(X, T, V)                    \
+  B2(X, T, V, V##_proj)           \
+  B2(X, T, V, V##_rej)            \
+  X(N2, T, V, T, V##_angle, _, _) \
+  X(N2, T, V, T, V##_dot, _, _)
+
+#define FLOAT2(X, T, V)           \
+  ARITH(X, T, V)                  \
+  GEO23(X, T, V)                  \
+  B2F(X, T, V, V##_rot, T, (T) 1) \
+  X(N2, T, V, T, V##_cross, _, _)
+
+#define FLOAT3(X, T, V, Q)            \
+  ARITH(X, T, V)                      \
+  GEO23(X, T, V)                      \
+  B2F(X, T, V, V##_rot, Q, Q##_qid()) \
+  B2(X, T, V, V##_cross)
+
+#define POLY(X, T, V)                 \
+  X(NP, T, V, V, V##_poly, size_t, 4) \
+  X(LP, T, V, V, V##_poly, size_t, 4)
+
+#define TRIG(X, T, V)              \
+  X(L1, T, V, V, V##_sin, _, _)    \
+  X(S1, T, V, V, V##_sin, _, _)    \
+  X(L1, T, V, V, V##_cos, _, _)    \
+  X(S1, T, V, V, V##_cos, _, _)    \
+  X(SC, T, V, V, V##_sincos, _, _) \
+  X(S1, T, V, V, V##_tan, _, _)    \
+  X(S1, T, V, V, V##_asin, _, _)   \
+  X(S1, T, V, V, V##_acos, _, _)   \
+  X(S1, T, V, V, V##_atan, _, _)   \
+  X(S2, T, V, V, V##_atan2, _, _)
+
+#define FLOAT4(X, T, V, V3, M, M3)          \
+  ARITH(X, T, V)                            \
+  GEO(X, T, V)                              \
+  TRIG(X, T, V)                             \
+  B2(X, T, V, V##_qmul)                     \
+  X(N1, T, V, V, V##_qconj, _, _)           \
+  B1(X, T, V, V##_qinv)                     \
+  X(NQ, T, V, V, V##_qnlerp, T, (T) 0.5)    \
+  X(LQ, T, V, V, V##_qnlerp, T, (T) 0.5)    \
+  X(NQ, T, V, V, V##_qslerp, T, (T) 0.5)    \
+  X(LQ, T, V, V, V##_qslerp, T, (T) 0.5)    \
+  X(N2P, T, V, V3, V##_qrot, V3, _)         \
+  X(LF2, T, V3, V3, V##_qrot, V, V##_qid()) \
+  X(S2F, T, V3, V, V##_qaxis, T, (T) 1)     \
+  X(S1, T, V, M, V##_qmat, _, _)            \
+  X(S1, T, V, M3, V##_qmat3, _, _)          \
+  X(N1, T, V3, T##x3p, V3##_pack, _, _)     \
+  X(N1, T, T##x3p, V3, V3##_unpack, _, _)   \
+  X(NM, T, V, V, M##_mulv, M, _)            \
+  X(NM, T, V3, V3, M##_mulp, M, _)          \
+  X(LM, T, M, M, M##_mul, _, _)             \
+  X(LM1, T, M, M, M##_inv, _, _)            \
+  X(LM, T, M3, M3, M3##_mul, _, _)          \
+  X(LM1, T, M3, M3, M3##_inv, _, _)
+
+#define BITS(X, T, V)             \
+  B2(X, T, V, V##_and)            \
+  B2(X, T, V, V##_or)             \
+  B2(X, T, V, V##_xor)            \
+  X(N1, T, V, V, V##_not, _, _)   \
+  B2(X, T, V, V##_andnot)         \
+  B2(X, T, V, V##_shl)            \
+  B2(X, T, V, V##_shr)            \
+  B2F(X, T, V, V##_shlf, int, 1)  \
+  B2F(X, T, V, V##_shrf, int, 1)  \
+  B2(X, T, V, V##_rotl)           \
+  B2(X, T, V, V##_rotr)           \
+  B2F(X, T, V, V##_rotlf, int, 1) \
+  B2F(X, T, V, V##_rotrf, int, 1) \
+  B2F(X, T, V, V##_div_by, T##div, T##div_set((T) 3))
+
+#define SAT(X, T, V)    \
+  B2(X, T, V, V##_adds) \
+  B2(X, T, V, V##_subs) \
+  B2(X, T, V, V##_avg)
+
+#define MULHI(X, T, V)            \
+  X(L2, T, V, V, V##_mulhi, _, _) \
+  X(S2, T, V, V, V##_mulhi, _, _)
+
+#define INT(X, T, V) ARITH(X, T, V) BITS(X, T, V) MULHI(X, T, V)
+#define SMALL(X, T, V) INT(X, T, V) SAT(X, T, V)
+
+#define WIDTHS(X, F, T) \
+  F(X, T, T##x2) F(X, T, T##x3) F(X, T, T##x4) F(X, T, T##x8) F(X, T, T##x16)
+
+/*
+** WIDTHS2 pairs each width of `T` with the same width of `U`: the mask type
+** for CMPS, the wide type for WIDEN and the narrow one for PACKS and PACKUS.
+*/
+
+#define WIDTHS2(X, F, T, U)                   \
+  F(X, T, T##x2, U##x2) F(X, T, T##x3, U##x3) \
+  F(X, T, T##x4, U##x4) F(X, T, T##x8, U##x8) \
+  F(X, T, T##x16, U##x16)
+
+#define CMPS(X, T, V, M)             \
+  X(S2, T, V, M, V##_eq, _, _)       \
+  X(S2, T, V, M, V##_lt, _, _)       \
+  X(S2, T, V, M, V##_le, _, _)       \
+  X(LSEL, T, V, V, V##_select, M, _) \
+  X(SEL, T, V, V, V##_select, M, _)
+
+#define MASKS(X, T, M)             \
+  X(S1, T, M, bool, M##_any, _, _) \
+  X(S1, T, M, bool, M##_all, _, _)
+
+#define WIDEN(X, T, V, VW)         \
+  X(S1, T, V, VW, V##_widen, _, _) \
+  X(S2, T, V, VW, V##_mulw, _, _)  \
+  X(S3, T, V, VW, V##_maddw, VW, _)
+
+#define PACKS(X, T, V, VN) X(S1, T, V, VN, V##_packs, _, _)
+#define PACKUS(X, T, V, VN) X(S1, T, V, VN, V##_packus, _, _)
+
+#define MADD(X)                              \
+  X(S2, i16, i16x4, i32x2, i16x4_madd, _, _) \
+  X(S2, i16, i16x8, i32x4, i16x8_madd, _, _) \
+  X(S2, i16, i16x16, i32x8, i16x16_madd, _, _)
+
+#define SOA2(X, T, S)                 \
+  X(A2F, T, S, S, S##_rot, T, (T) 1)  \
+  X(A1, T, S, S, S##_norm, _, _)      \
+  X(A1, T, S, S, S##_norm_fast, _, _) \
+  X(A1, T, S, T, S##_mag, _, _)       \
+  X(A2, T, S, S, S##_proj, _, _)      \
+  X(A2, T, S, T, S##_cross, _, _)     \
+  X(A2, T, S, T, S##_angle, _, _)     \
+  X(A2, T, S, T, S##_dot, _, _)
+
+#define SOA3(X, T, S, Q)                 \
+  X(A2F, T, S, S, S##_rot, Q, Q##_qid()) \
+  X(A1, T, S, S, S##_norm, _, _)         \
+  X(A1, T, S, S, S##_norm_fast, _, _)    \
+  X(A1, T, S, T, S##_mag, _, _)          \
+  X(A2, T, S, S, S##_proj, _, _)         \
+  X(A2, T, S, S, S##_cross, _, _)        \
+  X(A2, T, S, T, S##_angle, _, _)        \
+  X(A2, T, S, T, S##_dot, _, _)
+
+#define REV_2 (1, 0)
+#define REV_3 (2, 1, 0)
+#define REV_4 (3, 2, 1, 0)
+#define REV_8 (7, 6, 5, 4, 3, 2, 1, 0)
+#define REV_16 (15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define LO_2 (0, 2)
+#define LO_3 (0, 3, 1)
+#define LO_4 (0, 4, 1, 5)
+#define LO_8 (0, 8, 1, 9, 2, 10, 3, 11)
+#define LO_16 (0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23)
+
+#define SHUF(X, T, W)                                         \
+  X(LSH, T, T##x##W, T##x##W, T##x##W##_shuffle, _, REV_##W)  \
+  X(LSH2, T, T##x##W, T##x##W, T##x##W##_shuffle2, _, LO_##W) \
+  X(SSH, T, T##x##W, T##x##W, T##x##W##_splat, _, (1))
+
+#define SHUFFLE(X, T)                       \
+  SHUF(X, T, 2) SHUF(X, T, 3) SHUF(X, T, 4) \
+  SHUF(X, T, 8) SHUF(X, T, 16)              \
+  X(L1, T, T##x2, T##x2, T##x2_yx, _, _)    \
+  X(L1, T, T##x3, T##x3, T##x3_zxy, _, _)   \
+  X(L1, T, T##x4, T##x4, T##x4_wzyx, _, _)  \
+  X(L1, T, T##x4, T##x4, T##x4_xxzz, _, _)
+
+#define HALF(X, W)                                     \
+  X(N1, f32, f32x##W, f16x##W, f32x##W##_to_f16, _, _) \
+  X(N1, f32, f16x##W, f32x##W, f16x##W##_to_f32, _, _)
+
+#define SCALAR(X, T)                    \
+  X(L1, T, T, T, T##_abs, _, _)         \
+  X(S1, T, T, T, T##_abs, _, _)         \
+  X(L2F, T, T, T, T##_neg_if, u64, 1)   \
+  X(S2F, T, T, T, T##_neg_if, u64, 1)   \
+  X(L1, T, T, T, T##_floor, _, _)       \
+  X(S1, T, T, T, T##_floor, _, _)       \
+  X(L2, T, T, T, T##_mod, _, _)         \
+  X(S2, T, T, T, T##_mod, _, _)         \
+  X(L3, T, T, T, T##_fma, _, _)         \
+  X(S3, T, T, T, T##_fma, T, _)         \
+  X(L1, T, T, T, T##_sqrt, _, _)        \
+  X(S1, T, T, T, T##_sqrt, _, _)        \
+  X(L1, T, T, T, T##_rsqrt, _, _)       \
+  X(N1, T, T, T, T##_rsqrt, _, _)       \
+  X(L1, T, T, T, T##_sin_fast, _, _)    \
+  X(S1, T, T, T, T##_sin_fast, _, _)    \
+  X(L1, T, T, T, T##_sin_mid, _, _)     \
+  X(S1, T, T, T, T##_sin_mid, _, _)     \
+  X(L1, T, T, T, T##_sin_precise, _, _) \
+  X(S1, T, T, T, T##_sin_precise, _, _) \
+  X(L1, T, T, T, T##_cos_fast, _, _)    \
+  X(S1, T, T, T, T##_cos_fast, _, _)    \
+  X(L1, T, T, T, T##_cos_mid, _, _)     \
+  X(S1, T, T, T, T##_cos_mid, _, _)     \
+  X(L1, T, T, T, T##_cos_precise, _, _) \
+  X(S1, T, T, T, T##_cos_precise, _, _) \
+  X(SC, T, T, T, T##_sincos_mid, _, _)  \
+  X(S1, T, T, T, T##_tan_fast, _, _)    \
+  X(S1, T, T, T, T##_tan_mid, _, _)     \
+  X(S1, T, T, T, T##_tan_precise, _, _) \
+  X(S1, T, T, T, T##_asin, _, _)        \
+  X(S1, T, T, T, T##_acos, _, _)        \
+  X(S1, T, T, T, T##_atan, _, _)        \
+  X(R1, T, T, T, T##_sum_precise, _, _) \
+  X(R2, T, T, T, T##_dot_precise, _, _)
+
+#define REDUCE(X, T)            \
+  X(R1, T, T, T, T##_sum, _, _) \
+  X(R2, T, T, T, T##_dot, _, _) \
+  X(R1, T, T, T, T##_min, _, _) \
+  X(R1, T, T, T, T##_max, _, _) \
+  X(MM, T, T, T, T##_minmax, _, _)
+
+#define ILV(X, T)                         \
+  X(D2, T, T, T, T##_deinterleave2, _, _) \
+  X(D3, T, T, T, T##_deinterleave3, _, _) \
+  X(D4, T, T, T, T##_deinterleave4, _, _) \
+  X(I2, T, T, T, T##_interleave2, _, _)   \
+  X(I3, T, T, T, T##_interleave3, _, _)   \
+  X(I4, T, T, T, T##_interleave4, _, _)
+
+#define ALL(X)                                          \
+  SCALAR(X, f32) SCALAR(X, f64)                         \
+  POLY(X, f32, f32) POLY(X, f64, f64)                   \
+  WIDTHS(X, POLY, f32) WIDTHS(X, POLY, f64)             \
+  REDUCE(X, f32) REDUCE(X, f64)                         \
+  REDUCE(X, i8) REDUCE(X, i16)                          \
+  REDUCE(X, i32) REDUCE(X, i64)                         \
+  REDUCE(X, u8) REDUCE(X, u16)                          \
+  REDUCE(X, u32) REDUCE(X, u64)                         \
+  ILV(X, f32) ILV(X, f64)                               \
+  ILV(X, i8) ILV(X, i16)                                \
+  ILV(X, i32) ILV(X, i64)                               \
+  ILV(X, u8) ILV(X, u16)                                \
+  ILV(X, u32) ILV(X, u64)                               \
+  SHUFFLE(X, f32) SHUFFLE(X, f64)                       \
+  SHUFFLE(X, i8) SHUFFLE(X, i16)                        \
+  SHUFFLE(X, i32) SHUFFLE(X, i64)                       \
+  SHUFFLE(X, u8) SHUFFLE(X, u16)                        \
+  SHUFFLE(X, u32) SHUFFLE(X, u64)                       \
+  X(N1, f32, f32, f16, f32_to_f16, _, _)                \
+  X(N1, f32, f16, f32, f16_to_f32, _, _)                \
+  HALF(X, 2) HALF(X, 3) HALF(X, 4)                      \
+  SOA2(X, f32, f32x2s) SOA2(X, f64, f64x2s)             \
+  SOA3(X, f32, f32x3s, f32x4)                           \
+  SOA3(X, f64, f64x3s, f64x4)                           \
+  TRIG(X, f32, f32l) TRIG(X, f64, f64l)                 \
+  FLOAT2(X, f32, f32x2) FLOAT2(X, f64, f64x2)           \
+  FLOAT3(X, f32, f32x3, f32x4)                          \
+  FLOAT3(X, f64, f64x3, f64x4)                          \
+  FLOAT4(X, f32, f32x4, f32x3, f32x4x4, f32x3x3)        \
+  FLOAT4(X, f64, f64x4, f64x3, f64x4x4, f64x3x3)        \
+  ARITH(X, f32, f32x8) ARITH(X, f32, f32x16)            \
+  ARITH(X, f64, f64x8) ARITH(X, f64, f64x16)            \
+  WIDTHS(X, SMALL, i8) WIDTHS(X, SMALL, i16)            \
+  WIDTHS(X, INT, i32) WIDTHS(X, INT, i64)               \
+  WIDTHS(X, SMALL, u8) WIDTHS(X, SMALL, u16)            \
+  WIDTHS(X, INT, u32) WIDTHS(X, INT, u64)               \
+  WIDTHS2(X, CMPS, f32, i32)                            \
+  WIDTHS2(X, CMPS, f64, i64)                            \
+  WIDTHS2(X, CMPS, i8, i8) WIDTHS2(X, CMPS, i16, i16)   \
+  WIDTHS2(X, CMPS, i32, i32) WIDTHS2(X, CMPS, i64, i64) \
+  WIDTHS2(X, CMPS, u8, i8) WIDTHS2(X, CMPS, u16, i16)   \
+  WIDTHS2(X, CMPS, u32, i32) WIDTHS2(X, CMPS, u64, i64) \
+  WIDTHS(X, MASKS, i8) WIDTHS(X, MASKS, i16)            \
+  WIDTHS(X, MASKS, i32) WIDTHS(X, MASKS, i64)           \
+  WIDTHS2(X, WIDEN, i8, i16)                            \
+  WIDTHS2(X, WIDEN, i16, i32)                           \
+  WIDTHS2(X, WIDEN, u8, u16)                            \
+  WIDTHS2(X, WIDEN, u16, u32)                           \
+  WIDTHS2(X, PACKS, i16, i8)                            \
+  WIDTHS2(X, PACKUS, i16, u8)                           \
+  WIDTHS2(X, PACKS, i32, i16)                           \
+  WIDTHS2(X, PACKUS, i32, u16)                          \
+  MADD(X)
+
+ALL(DEF)
+
+typedef struct {
+  const char* name;
+  const char* metric;
+  void (*fill)(void);
+  void (*run)(size_t reps);
+  size_t per;
+} bench;
+
+static const bench benches[] = {ALL(ROW)};
+
+/*
+** Timing
+**
+** The repeat count doubles until one sample takes SAMPLE_NS, which also
+** serves as the warmup. Cycles come from the TSC, which ticks at a fixed
+** rate rather than the core clock, so they are only comparable on one
+** machine; `ns` is the column to diff across machines.
+*/
+
+static f64 now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (f64) ts.tv_sec * 1e9 + (f64) ts.tv_nsec;
+}
+
+static u64 ticks(void) {
+  #if BENCH_TSC
+    return (u64) __rdtsc();
+  #else
+    return 0;
+  #endif
+}
+
+static void pin(void) {
+  #if defined(__linux__) && !defined(SOL_THREADS)
+    const int cpu = sched_getcpu();
+    if (cpu >= 0) {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(cpu, &set);
+      sched_setaffinity(0, sizeof set, &set);
+    }
+  #endif
+}
+
+static void measure(const bench* b, f64* ns, f64* cycles) {
+  b->fill();
+  b->run(1);
+  size_t reps = 1;
+  for (;;) {
+    const f64 t = now();
+    b->run(reps);
+    if (now() - t >= SAMPLE_NS || reps >= ((size_t) 1 << 40))
+      break;
+    reps *= 2;
+  }
+  *ns = *cycles = 0;
+  for (int s = 0; s < SAMPLES; s++) {
+    const f64 t = now();
+    const u64 c = ticks();
+    b->run(reps);
+    const f64 dc = (f64) (ticks() - c);
+    const f64 dt = now() - t;
+    const f64 per = (f64) reps * (f64) b->per;
+    if (s == 0 || dt / per < *ns) {
+      *ns = dt / per;
+      *cycles = dc / per;
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  int json = 0, header = 1;
+  const char* filter = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-j"))
+      json = 1;
+    else if (!strcmp(argv[i], "-q"))
+      header = 0;
+    else
+      filter = argv[i];
+  }
+  pin();
+  PAR(sol_chunk_set(CHUNK);)
+  if (!json && header)
+    printf("backend,function,metric,ns,cycles\n");
+  for (size_t i = 0; i < sizeof benches / sizeof benches[0]; i++) {
+    const bench* b = &benches[i];
+    if (filter && !strstr(b->name, filter))
+      continue;
+    f64 ns, cycles;
+    measure(b, &ns, &cycles);
+    if (json)
+      printf("{\"backend\":\"%s\",\"function\":\"%s\",\"metric\":\"%s\","
+             "\"ns\":%.3f,\"cycles\":%.2f}\n",
+             BENCH_BACKEND, b->name, b->metric, ns, cycles);
+    else
+      printf("%s,%s,%s,%.3f,%.2f\n", BENCH_BACKEND, b->name, b->metric, ns, cycles);
+    fflush(stdout);
+  }
+  return 0;
+}
@@ -1,3 +1,13 @@
+/*
+** disas.c | The Sol Vector Library | One wrapper per function, for objdump.
+** https://github.com/davidgarland/sol
+**
+** Every function below is `w_F`, an out-of-line copy of `F` that objdump can
+** find. `make disas` writes the assembly for a read, and `tests/disas.sh`
+** counts the instructions, calls and scalar math in each wrapper against the
+** budgets in `tests/disas.txt`.
+*/
+
 #include "../sol.h"
 
 f32x2 fma32x2(f32x2 a, f32x2 b, f32x2 c) {
@@ -15,3 +25,196 @@ f64x2 fma64x2(f64x2 a, f64x2 b, f64x2 c) {
 f64x4 fma64x4(f64x4 a, f64x4 b, f64x4 c) {
   return f64x4_fma(a, b, c);
 }
+
+/*
+** Wrappers
+*/
+
+#define W1(R, F, A) \
+R w_##F(A a) {      \
+  return F(a);      \
+}
+
+#define W2(R, F, A, B) \
+R w_##F(A a, B b) {    \
+  return F(a, b);      \
+}
+
+#define W3(R, F, A, B, C) \
+R w_##F(A a, B b, C c) {  \
+  return F(a, b, c);      \
+}
+
+#define WI1(V, F, ...)      \
+V w_##F(V a) {              \
+  return F(a, __VA_ARGS__); \
+}
+
+#define WI2(V, F, ...)         \
+V w_##F(V a, V b) {            \
+  return F(a, b, __VA_ARGS__); \
+}
+
+/*
+** Families
+*/
+
+#define ARITH(T, V)          \
+  W1(T, V##_sum, V)          \
+  W1(V, V##_sq, V)           \
+  W2(V, V##_add, V, V)       \
+  W2(V, V##_addf, V, T)      \
+  W2(V, V##_sub, V, V)       \
+  W2(V, V##_subf, V, T)      \
+  W2(V, V##_fsub, T, V)      \
+  W2(V, V##_mul, V, V)       \
+  W2(V, V##_mulf, V, T)      \
+  W2(V, V##_div, V, V)       \
+  W2(V, V##_divf, V, T)      \
+  W2(V, V##_fdiv, T, V)      \
+  W3(V, V##_fma, V, V, V)    \
+  W3(V, V##_fms, V, V, V)
+
+#define CMP(V, M)            \
+  W2(M, V##_eq, V, V)        \
+  W2(M, V##_ne, V, V)        \
+  W2(M, V##_lt, V, V)        \
+  W2(M, V##_le, V, V)        \
+  W2(M, V##_gt, V, V)        \
+  W2(M, V##_ge, V, V)        \
+  W3(V, V##_select, M, V, V) \
+  W2(V, V##_min, V, V)       \
+  W2(V, V##_max, V, V)       \
+  W3(V, V##_clamp, V, V, V)
+
+#define GEO(T, V)            \
+  W2(V, V##_scale, V, T)     \
+  W1(V, V##_norm, V)         \
+  W1(V, V##_norm_fast, V)    \
+  W1(T, V##_mag, V)
+
+#define GEO23(T, V)          \
+  GEO(T, V)                  \
+  W2(V, V##_proj, V, V)      \
+  W2(V, V##_rej, V, V)       \
+  W2(T, V##_angle, V, V)     \
+  W2(T, V##_dot, V, V)
+
+#define BITS(V)              \
+  W2(V, V##_and, V, V)       \
+  W2(V, V##_or, V, V)        \
+  W2(V, V##_xor, V, V)       \
+  W1(V, V##_not, V)          \
+  W2(V, V##_andnot, V, V)    \
+  W2(V, V##_shl, V, V)       \
+  W2(V, V##_shr, V, V)       \
+  W2(V, V##_shlf, V, int)    \
+  W2(V, V##_shrf, V, int)    \
+  W2(V, V##_rotl, V, V)      \
+  W2(V, V##_rotr, V, V)      \
+  W2(V, V##_rotlf, V, int)   \
+  W2(V, V##_rotrf, V, int)
+
+#define SAT(V)               \
+  W2(V, V##_adds, V, V)      \
+  W2(V, V##_subs, V, V)      \
+  W2(V, V##_avg, V, V)
+
+#define SWZW(T)                                                       \
+  WI1(T##x2, T##x2_shuffle, 1, 0)                                     \
+  WI2(T##x2, T##x2_shuffle2, 0, 2)                                    \
+  WI1(T##x2, T##x2_splat, 1)                                          \
+  W1(T##x2, T##x2_yx, T##x2)                                          \
+  WI1(T##x3, T##x3_shuffle, 2, 1, 0)                                  \
+  WI2(T##x3, T##x3_shuffle2, 0, 3, 1)                                 \
+  WI1(T##x3, T##x3_splat, 1)                                          \
+  W1(T##x3, T##x3_zxy, T##x3)                                         \
+  WI1(T##x4, T##x4_shuffle, 3, 2, 1, 0)                               \
+  WI2(T##x4, T##x4_shuffle2, 0, 4, 1, 5)                              \
+  WI1(T##x4, T##x4_splat, 1)                                          \
+  W1(T##x4, T##x4_zwxy, T##x4)                                        \
+  W1(T##x4, T##x4_xxyy, T##x4)                                        \
+  WI1(T##x8, T##x8_shuffle, 7, 6, 5, 4, 3, 2, 1, 0)                   \
+  WI2(T##x8, T##x8_shuffle2, 0, 8, 1, 9, 2, 10, 3, 11)                \
+  WI1(T##x8, T##x8_splat, 1)                                          \
+  WI1(T##x16, T##x16_shuffle, 15, 14, 13, 12, 11, 10, 9, 8,           \
+      7, 6, 5, 4, 3, 2, 1, 0)                                         \
+  WI2(T##x16, T##x16_shuffle2, 0, 16, 1, 17, 2, 18, 3, 19,            \
+      4, 20, 5, 21, 6, 22, 7, 23)                                     \
+  WI1(T##x16, T##x16_splat, 1)
+
+#define FLOATW(T, V, M) ARITH(T, V) CMP(V, M)
+#define INTW(T, V, M, D) ARITH(T, V) CMP(V, M) BITS(V) W2(V, V##_div_by, V, D)
+#define SMALLW(T, V, M, D) INTW(T, V, M, D) SAT(V)
+
+#define WIDTHS(F, T, M, ...)                                     \
+  F(T, T##x2, M##x2, __VA_ARGS__) F(T, T##x3, M##x3, __VA_ARGS__) \
+  F(T, T##x4, M##x4, __VA_ARGS__) F(T, T##x8, M##x8, __VA_ARGS__) \
+  F(T, T##x16, M##x16, __VA_ARGS__)
+
+#define FLOAT(T, M)                                    \
+  FLOATW(T, T##x2, M##x2) FLOATW(T, T##x3, M##x3)      \
+  FLOATW(T, T##x4, M##x4) FLOATW(T, T##x8, M##x8)      \
+  FLOATW(T, T##x16, M##x16)                            \
+  GEO23(T, T##x2)                                      \
+  W2(T##x2, T##x2_rot, T##x2, T)                       \
+  W2(T, T##x2_cross, T##x2, T##x2)                     \
+  GEO23(T, T##x3)                                      \
+  W2(T##x3, T##x3_rot, T##x3, T##x4)                   \
+  W2(T##x3, T##x3_cross, T##x3, T##x3)                 \
+  W1(T##x3, T##x3_yzx, T##x3)                          \
+  GEO(T, T##x4)                                        \
+  W2(T##x4, T##x4_qmul, T##x4, T##x4)                  \
+  W1(T##x4, T##x4_qconj, T##x4)                        \
+  W1(T##x4, T##x4_qinv, T##x4)                         \
+  W2(T##x3, T##x4_qrot, T##x4, T##x3)                  \
+  W3(T##x4, T##x4_qnlerp, T##x4, T##x4, T)             \
+  W1(T##x4, T##x4_sin, T##x4)                          \
+  W1(T##x4, T##x4_cos, T##x4)                          \
+  W1(T##x4, T##x4_tan, T##x4)                          \
+  W1(T##x4, T##x4_atan, T##x4)                         \
+  W2(T##x4, T##x4x4_mulv, T##x4x4, T##x4)              \
+  W2(T##x3, T##x4x4_mulp, T##x4x4, T##x3)              \
+  W2(T##x4x4, T##x4x4_mul, T##x4x4, T##x4x4)           \
+  W1(T##x4x4, T##x4x4_trans, T##x4x4)                  \
+  W1(T, T##x4x4_det, T##x4x4)                          \
+  W1(T##x4x4, T##x4x4_inv, T##x4x4)                    \
+  W2(T##x3, T##x3x3_mulv, T##x3x3, T##x3)              \
+  W2(T##x3x3, T##x3x3_mul, T##x3x3, T##x3x3)           \
+  W1(T##x3x3, T##x3x3_inv, T##x3x3)                    \
+  W1(T, T##_sqrt, T)                                   \
+  W1(T, T##_rsqrt, T)                                  \
+  W1(T, T##_floor, T)                                  \
+  W3(T, T##_fma, T, T, T)                              \
+  W3(T, T##_fms, T, T, T)                              \
+  W3(T, T##_poly, T, const T*, size_t)                 \
+  W3(T##x4, T##x4_poly, T##x4, const T*, size_t)       \
+  W1(T, T##_sin_fast, T)                               \
+  W1(T, T##_sin_mid, T)                                \
+  W1(T, T##_sin_precise, T)                            \
+  W1(T, T##_cos_fast, T)                               \
+  W1(T, T##_tan_fast, T)                               \
+  W1(T, T##_atan, T)
+
+FLOAT(f32, i32)
+FLOAT(f64, i64)
+
+SWZW(f32)
+SWZW(f64)
+SWZW(i8)
+SWZW(i16)
+SWZW(i32)
+SWZW(i64)
+SWZW(u8)
+SWZW(u16)
+SWZW(u32)
+SWZW(u64)
+
+WIDTHS(SMALLW, i8, i8, i8div)
+WIDTHS(SMALLW, i16, i16, i16div)
+WIDTHS(INTW, i32, i32, i32div)
+WIDTHS(INTW, i64, i64, i64div)
+WIDTHS(SMALLW, u8, i8, u8div)
+WIDTHS(SMALLW, u16, i16, u16div)
+WIDTHS(INTW, u32, i32, u32div)
+WIDTHS(INTW, u64, i64, u64div)
@@ -0,0 +1,165 @@
+#!/bin/sh
+#
+# disas.sh | The Sol Vector Library | Instruction budgets for tests/disas.c.
+# https://github.com/davidgarland/sol
+#
+# Builds tests/disas.c once per config below and counts, for every `w_`
+# wrapper, its instructions (without alignment padding), its calls (relocated
+# calls and tail calls, so libm or memcpy showing up counts, and any call or
+# jump into another function of the object, such as an outlined `static
+# inline` that stopped inlining), and its scalar
+# floating-point math and lane inserts/extracts, the usual signs of a vector
+# function that was taken apart a lane at a time.
+#
+#   sh tests/disas.sh check   fails if any count is over its budget
+#   sh tests/disas.sh report  lists the overruns without failing
+#   sh tests/disas.sh update  writes the current counts as the budgets
+#
+# The budgets depend on the compiler, so tests/disas.txt records which one
+# wrote it, and check fails outright under any other; `make disas` builds
+# with DISAS_CC, which defaults to the one the budgets were recorded with.
+
+set -e
+
+mode=${1:-check}
+CC=${CC:-cc}
+budget=tests/disas.txt
+tmp=${TMPDIR:-/tmp}/sol-disas.$$
+trap 'rm -rf "$tmp"' EXIT INT TERM
+mkdir -p "$tmp"
+
+configs="sse avx2"
+flags_sse="-DSOL_GNU"
+flags_avx2="-DSOL_GNU -mavx2 -mfma"
+
+cc_id=$($CC --version | head -n 1)
+
+if [ "$mode" != update ]; then
+  [ -f "$budget" ] || { echo "no $budget; run 'make disas-budget'"; exit 1; }
+
+  strict=1
+  [ "$mode" = report ] && strict=0
+  if ! grep -qF "with: $cc_id" "$budget"; then
+    echo "disas: $budget was not written by $cc_id" >&2
+    sed -n 's/^# written by .* with: /disas: it was written by /p' "$budget" >&2
+    if [ "$strict" = 1 ]; then
+      echo "disas: set DISAS_CC to that compiler, or use 'sh tests/disas.sh report'" >&2
+      exit 1
+    fi
+  fi
+fi
+
+for c in $configs; do
+  eval "flags=\$flags_$c"
+  # shellcheck disable=SC2086
+  $CC -std=c99 -O2 -Wno-psabi $CFLAGS $flags -c tests/disas.c -o "$tmp/$c.o"
+  objdump -d -r --no-show-raw-insn "$tmp/$c.o" | awk -v c="$c" '
+    /^[0-9a-f]+ <.*>:$/ {
+      f = substr($2, 2, length($2) - 3)
+      if (f !~ /^w_/)
+        f = ""
+      else
+        order[++k] = f
+      next
+    }
+    f == "" { next }
+    /R_[A-Z0-9_]*(PLT32|CALL26|JUMP26)/ {
+      if (!pend)
+        calls[f]++
+      pend = 0
+      next
+    }
+    /^ *[0-9a-f]+:\t/ {
+      pend = 0
+      split($0, p, "\t")
+      op = p[2]
+      if (op ~ /nop|xchg +%ax,%ax/)
+        next
+      t = op
+      sub(/ .*/, "", op)
+      insns[f]++
+      if (op ~ /^(call|j[a-z]+)q?$/ && t ~ /<[^>]*>$/) {
+        sub(/.*</, "", t)
+        sub(/[+>].*/, "", t)
+        if (t != f) {
+          calls[f]++
+          pend = 1
+        }
+      }
+      if (op ~ /^v?(add|sub|mul|div|sqrt|min|max|rcp|rsqrt|round)s[sd]$/ ||
+          op ~ /^vf(n?)m(add|sub)[0-9]+s[sd]$/ ||
+          op ~ /^v?(pextr|pinsr)[bwdq]$/)
+        scalar[f]++
+    }
+    END {
+      for (i = 1; i <= k; i++)
+        print order[i], c, insns[order[i]] + 0, calls[order[i]] + 0, scalar[order[i]] + 0
+    }' > "$tmp/$c.txt"
+done
+
+if [ "$mode" = update ]; then
+  {
+    echo "# tests/disas.txt | instruction budgets for tests/disas.c"
+    echo "# written by 'make disas-budget' with: $cc_id"
+    echo "#"
+    echo "# per config: instructions, calls, scalar math or lane inserts/extracts"
+    echo "#"
+    printf "# %-30s" "function"
+    for c in $configs; do printf " %14s" "$c"; done
+    echo
+    cat "$tmp"/*.txt | awk -v configs="$configs" '
+      { if (!($1 in seen)) { seen[$1] = 1; order[++k] = $1 }
+        cell[$1, $2] = sprintf("%5d %4d %4d", $3, $4, $5) }
+      END {
+        n = split(configs, cs, " ")
+        for (i = 1; i <= k; i++) {
+          line = sprintf("%-32s", order[i])
+          for (j = 1; j <= n; j++)
+            line = line " " cell[order[i], cs[j]]
+          print line
+        }
+      }'
+  } > "$budget"
+  echo "wrote $budget"
+  exit 0
+fi
+
+cat "$tmp"/*.txt | awk -v configs="$configs" -v strict="$strict" -v budget="$budget" '
+  BEGIN {
+    n = split(configs, cs, " ")
+    while ((getline line < budget) > 0) {
+      if (line ~ /^#/ || line == "")
+        continue
+      split(line, w, " ")
+      for (j = 1; j <= n; j++) {
+        have[w[1], cs[j]] = 1
+        bi[w[1], cs[j]] = w[2 + 3 * (j - 1)]
+        bc[w[1], cs[j]] = w[3 + 3 * (j - 1)]
+        bs[w[1], cs[j]] = w[4 + 3 * (j - 1)]
+      }
+    }
+  }
+  {
+    f = $1; c = $2; total++
+    if (!((f, c) in have)) {
+      printf "%s %s: no budget (%d insns, %d calls, %d scalar)\n", f, c, $3, $4, $5
+      bad++
+      next
+    }
+    over = ""
+    if ($3 > bi[f, c]) over = over sprintf(" %d insns > %d", $3, bi[f, c])
+    if ($4 > bc[f, c]) over = over sprintf(" %d calls > %d", $4, bc[f, c])
+    if ($5 > bs[f, c]) over = over sprintf(" %d scalar > %d", $5, bs[f, c])
+    if (over != "") {
+      printf "%s %s:%s\n", f, c, over
+      bad++
+    } else if ($3 < bi[f, c]) {
+      under++
+    }
+  }
+  END {
+    printf "disas: %d checked, %d over budget, %d under\n", total, bad, under
+    if (under)
+      print "disas: run make disas-budget to tighten the budgets"
+    exit (bad && strict) ? 1 : 0
+  }'
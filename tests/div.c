@@ -0,0 +1,131 @@
+/*
+** div.c | The Sol Vector Library | Division by invariant integers.
+** https://github.com/davidgarland/sol
+**
+** `T_div_by`, `Tx4_div_by` and `Tx16_div_by` should agree with `/` for every
+** `n` and nonzero `d`. The 8 and 16 bit types are checked for every pair; the
+** 32 and 64 bit ones for 1, -1, MIN, MAX, every power of two and its negation,
+** and random divisors of every size, each against edge and random numerators.
+** `/` overflows for MIN / -1, so that one is taken to wrap back to MIN. `make
+** div` runs it for SOL_N_GNU, SOL_GNU and SOL_GNU with AVX2.
+*/
+
+#include <stdio.h>
+#include "../sol.h"
+
+#define LEN 65536
+
+static size_t bad;
+
+static u64 seed = 0x9e3779b97f4a7c15;
+
+static u64 rnd(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+/*
+** Each type gets its numerators `T_n`, the same again as `x4` and `x16`
+** vectors, and somewhere for the vector quotients to land.
+*/
+
+#define DECL(T)                                    \
+  static T T##_n[LEN], T##_a[LEN], T##_b[LEN];     \
+  static T##x4 T##_n4[LEN / 4], T##_q4[LEN / 4];   \
+  static T##x16 T##_n16[LEN / 16], T##_q16[LEN / 16];
+
+DECL(i8)  DECL(i16) DECL(i32) DECL(i64)
+DECL(u8)  DECL(u16) DECL(u32) DECL(u64)
+
+#define SQ(T, U, N, D) ((D) == -1 ? (T) ((U) 0 - (U) (N)) : (T) ((N) / (D)))
+#define UQ(T, U, N, D) ((T) ((N) / (D)))
+
+#define LOAD(T, CNT) {                      \
+  memcpy(T##_n4, T##_n, (CNT) * sizeof(T));  \
+  memcpy(T##_n16, T##_n, (CNT) * sizeof(T)); \
+}
+
+/*
+** CASE divides the first `CNT` numerators by `D` all three ways. `CNT` is a
+** multiple of 16, so every element goes through a vector.
+*/
+
+#define CASE(T, U, Q, C, FMT, D, CNT) {                                  \
+  const T d_ = (D);                                                      \
+  const T##div k_ = T##div_set(d_);                                      \
+  for (size_t j = 0; j < (CNT) / 4; j++)                                 \
+    T##_q4[j] = T##x4_div_by(T##_n4[j], k_);                             \
+  for (size_t j = 0; j < (CNT) / 16; j++)                                \
+    T##_q16[j] = T##x16_div_by(T##_n16[j], k_);                          \
+  memcpy(T##_a, T##_q4, (CNT) * sizeof(T));                              \
+  memcpy(T##_b, T##_q16, (CNT) * sizeof(T));                             \
+  for (size_t i = 0; i < (CNT); i++) {                                   \
+    const T n_ = T##_n[i], want = Q(T, U, n_, d_);                       \
+    const T s_ = T##_div_by(n_, k_);                                     \
+    if (s_ != want || T##_a[i] != want || T##_b[i] != want) {            \
+      if (bad++ < 20)                                                    \
+        printf(#T " " FMT " / " FMT ": want " FMT ", scalar " FMT        \
+               ", x4 " FMT ", x16 " FMT "\n", (C) n_, (C) d_, (C) want,  \
+               (C) s_, (C) T##_a[i], (C) T##_b[i]);                      \
+    }                                                                    \
+  }                                                                      \
+}
+
+/*
+** Every `n` against every nonzero `d`.
+*/
+
+#define ALL(T, U, Q, C, FMT, BITS) {       \
+  const size_t cnt = (size_t) 1 << (BITS); \
+  for (size_t i = 0; i < cnt; i++)         \
+    T##_n[i] = (T) (U) i;                  \
+  LOAD(T, cnt)                             \
+  for (size_t i = 1; i < cnt; i++)         \
+    CASE(T, U, Q, C, FMT, (T) (U) i, cnt)  \
+}
+
+/*
+** The wide types take `NUM` numerators: the edges first, then values of
+** random size. Divisors are shifted right by a random amount too, so small
+** ones are as common as large ones.
+*/
+
+#define NUM 4096
+
+#define SOME(T, U, Q, C, FMT, MIN, MAX) {                         \
+  const T edge[] = {0, 1, (T) -1, 2, (T) -2, 3, 7, 10, 100, MIN,  \
+                    (T) (MIN + 1), MAX, (T) (MAX - 1), MAX / 2,   \
+                    (T) (MAX / 2 + 1), (T) (MIN / 2)};            \
+  const size_t ne = sizeof(edge) / sizeof(edge[0]);               \
+  for (size_t i = 0; i < NUM; i++)                                \
+    T##_n[i] = (i < ne) ? edge[i]                                 \
+             : (T) (U) (rnd() >> (rnd() % (8 * sizeof(T))));      \
+  LOAD(T, NUM)                                                    \
+  CASE(T, U, Q, C, FMT, 1, NUM)                                   \
+  CASE(T, U, Q, C, FMT, (T) -1, NUM)                              \
+  CASE(T, U, Q, C, FMT, (MIN != 0) ? MIN : 1, NUM)                \
+  CASE(T, U, Q, C, FMT, MAX, NUM)                                 \
+  for (size_t k = 1; k < 8 * sizeof(T); k++) {                    \
+    CASE(T, U, Q, C, FMT, (T) ((U) 1 << k), NUM)                  \
+    CASE(T, U, Q, C, FMT, (T) ((U) 0 - ((U) 1 << k)), NUM)        \
+  }                                                               \
+  for (size_t k = 0; k < 2000; k++) {                             \
+    T d = (T) (U) (rnd() >> (rnd() % (8 * sizeof(T))));           \
+    CASE(T, U, Q, C, FMT, d ? d : 5, NUM)                         \
+  }                                                               \
+}
+
+int main(void) {
+  ALL(i8, u8, SQ, int, "%d", 8)
+  ALL(u8, u8, UQ, int, "%d", 8)
+  ALL(i16, u16, SQ, int, "%d", 16)
+  ALL(u16, u16, UQ, int, "%d", 16)
+  SOME(i32, u32, SQ, long long, "%lld", INT32_MIN, INT32_MAX)
+  SOME(u32, u32, UQ, long long, "%lld", 0, UINT32_MAX)
+  SOME(i64, u64, SQ, long long, "%lld", INT64_MIN, INT64_MAX)
+  SOME(u64, u64, UQ, unsigned long long, "%llu", 0, UINT64_MAX)
+  printf("%zu failures\n", bad);
+  return bad != 0;
+}
@@ -0,0 +1,77 @@
+/*
+** mul.c | The Sol Vector Library | Lane multiply speed against `A * B`.
+** https://github.com/davidgarland/sol
+**
+** For the lane widths with no native multiply this prints the time per vector
+** of the compiler's own lowering of `A * B` and of `V_mul`, and checks that
+** the two agree. Run it with `make mul`, and with `CFLAGS=-march=native` to
+** see the AVX2 and AVX-512DQ sequences.
+*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../sol.h"
+
+#define N (1 << 12)
+#define REPS 2000
+
+static u64x4 in[N], inb[N], out[N], outb[N];
+
+static f64 now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (f64) ts.tv_sec * 1e9 + (f64) ts.tv_nsec;
+}
+
+static void fill(void) {
+  srand(1);
+  for (size_t i = 0; i < sizeof in; i++) {
+    ((u8*) in)[i] = (u8) rand();
+    ((u8*) inb)[i] = (u8) rand();
+  }
+}
+
+/*
+** Both loops see the same arrays; the first result is kept so the second can
+** be checked against it.
+*/
+
+#define BENCH(V) {                                                   \
+  const V* a = (const V*) in;                                        \
+  const V* b = (const V*) inb;                                       \
+  V* o = (V*) out;                                                   \
+  V* ob = (V*) outb;                                                 \
+  f64 t = now();                                                     \
+  for (size_t r = 0; r < REPS; r++)                                  \
+    for (size_t i = 0; i < N; i++)                                   \
+      ob[i] = a[i] * b[i];                                           \
+  const f64 ta = (now() - t) / ((f64) REPS * N);                     \
+  t = now();                                                         \
+  for (size_t r = 0; r < REPS; r++)                                  \
+    for (size_t i = 0; i < N; i++)                                   \
+      o[i] = V##_mul(a[i], b[i]);                                    \
+  const f64 tb = (now() - t) / ((f64) REPS * N);                     \
+  const int ok = !memcmp(out, outb, N * sizeof(V));                  \
+  printf("%-8s %8.2f ns %8.2f ns %8.2fx %s\n", #V, ta, tb, ta / tb, \
+         ok ? "" : "MISMATCH");                                      \
+}
+
+int main(void) {
+  fill();
+  printf("%-8s %11s %11s %9s\n", "", "A * B", "V_mul", "speedup");
+  BENCH(i8x2)
+  BENCH(i8x4)
+  BENCH(i8x8)
+  BENCH(i8x16)
+  BENCH(u8x4)
+  BENCH(u8x8)
+  BENCH(u8x16)
+  BENCH(i64x2)
+  BENCH(i64x4)
+  BENCH(u64x2)
+  BENCH(u64x4)
+  return 0;
+}
@@ -0,0 +1,134 @@
+/*
+** norm.c | The Sol Vector Library | rsqrt and _norm_fast error over range.
+** https://github.com/davidgarland/sol
+**
+** For f64 this sweeps `f` over 1e-300..1e300 and prints the max relative error
+** of `f64_rsqrt` and `f64l_rsqrt` against `1 / sqrt`, and of the f64
+** `_norm_fast` functions against `_norm` wherever the squared magnitude stays
+** finite and normal. Anything past 1e-6 is marked and fails the run. Run it
+** with `make norm`, and with `CFLAGS=-mavx2` for the AVX lane path.
+**
+** It then feeds zero, a subnormal, a negative number, infinity and NaN to the
+** f32 and f64 rsqrt in every form (scalar, lane, `_n`, with the edge in one
+** lane among normal ones) and to the `_norm_fast` functions at zero, which
+** must match `1 / sqrt` and `v / mag(v)` exactly, NaN for NaN.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../sol.h"
+
+#define TOL 1e-6
+
+static f64 rel(f64 got, f64 want) {
+  return fabs(got / want - 1);
+}
+
+static f64 rel2(f64x2 got, f64x2 want) {
+  return fmax(rel(x(got), x(want)), rel(y(got), y(want)));
+}
+
+static f64 rel3(f64x3 got, f64x3 want) {
+  return fmax(rel2((f64x2) {x(got), y(got)}, (f64x2) {x(want), y(want)}),
+              rel(z(got), z(want)));
+}
+
+static f64 rel4(f64x4 got, f64x4 want) {
+  return fmax(rel3((f64x3) {x(got), y(got), z(got)},
+                   (f64x3) {x(want), y(want), z(want)}),
+              rel(w(got), w(want)));
+}
+
+static int same(f64 got, f64 want) {
+  if (want != want)
+    return got != got;
+  if (isinf(want) || want == 0)
+    return got == want;
+  return rel(got, want) <= TOL;
+}
+
+#define EDGE(T, L, V, W, SQRT, ...) {                                \
+  const T in[] = {__VA_ARGS__};                                      \
+  enum { n = sizeof(L) / sizeof(T) };                                \
+  for (size_t k = 0; k < sizeof in / sizeof *in; k++) {              \
+    T v[n], l[n], o[n], w[n];                                        \
+    for (size_t i = 0; i < n; i++) {                                 \
+      v[i] = (i == n - 1) ? in[k] : (T) (i + 2);                     \
+      w[i] = (T) 1 / SQRT(v[i]);                                     \
+    }                                                                \
+    L lv;                                                            \
+    memcpy(&lv, v, sizeof lv);                                       \
+    lv = L##_rsqrt(lv);                                              \
+    memcpy(l, &lv, sizeof lv);                                       \
+    T##_rsqrt_n(o, v, n);                                            \
+    for (size_t i = 0; i < n; i++) {                                 \
+      const T got[] = {T##_rsqrt(v[i]), l[i], o[i]};                 \
+      for (size_t j = 0; j < 3; j++)                                 \
+        if (!same(got[j], w[i])) {                                   \
+          printf(#T "_rsqrt(%g) form %zu: %g, want %g\n",            \
+                 (f64) v[i], j, (f64) got[j], (f64) w[i]);           \
+          bad++;                                                     \
+        }                                                            \
+    }                                                                \
+  }                                                                  \
+  const V z = {0};                                                   \
+  const V a = V##_norm_fast(z), b = V##_divf(z, V##_mag(z));         \
+  for (size_t i = 0; i < W; i++)                                     \
+    if (!same(vec(a)[i], vec(b)[i])) {                               \
+      printf(#V "_norm_fast(0) lane %zu: %g, want %g\n",             \
+             i, (f64) vec(a)[i], (f64) vec(b)[i]);                   \
+      bad++;                                                         \
+    }                                                                \
+}
+
+static int edges(void) {
+  int bad = 0;
+  EDGE(f32, f32l, f32x2, 2, sqrtf, 0, -0.0f, 1e-40f, -1, INFINITY, NAN, 1e-38f, 3e38f)
+  EDGE(f32, f32l, f32x4, 4, sqrtf, 0)
+  EDGE(f64, f64l, f64x3, 3, sqrt, 0, -0.0, 1e-310, -1, INFINITY, NAN, 1e-300, 1e300)
+  EDGE(f64, f64l, f64x4, 4, sqrt, 0)
+  printf("%-18s %10d %s\n", "edges", bad, bad ? "OVER" : "");
+  return bad != 0;
+}
+
+static int report(const char* name, f64 err) {
+  printf("%-18s %10.3e %s\n", name, err, err > TOL ? "OVER" : "");
+  return err > TOL;
+}
+
+int main(void) {
+  f64 rs = 0, rl = 0, n2 = 0, n3 = 0, n4 = 0;
+  srand(1);
+  for (int e = -300; e <= 300; e++) {
+    for (int k = 0; k < 16; k++) {
+      const f64 f = pow(10, e + (f64) rand() / RAND_MAX);
+      if (!isfinite(f))
+        continue;
+      rs = fmax(rs, rel(f64_rsqrt(f), 1 / sqrt(f)));
+      f64 l[sizeof(f64l) / sizeof(f64)];
+      const f64l lv = f64l_rsqrt(f64l_setf(f));
+      memcpy(l, &lv, sizeof lv);
+      for (size_t i = 0; i < sizeof l / sizeof *l; i++)
+        rl = fmax(rl, rel(l[i], 1 / sqrt(f)));
+      if (e < -150 || e >= 150)
+        continue;
+      const f64 a = sqrt(f), b = -a / 3, c = a * 2;
+      n2 = fmax(n2, rel2(f64x2_norm_fast((f64x2) {a, b}),
+                         f64x2_divf((f64x2) {a, b}, f64x2_mag((f64x2) {a, b}))));
+      n3 = fmax(n3, rel3(f64x3_norm_fast((f64x3) {a, b, c}),
+                         f64x3_divf((f64x3) {a, b, c},
+                                    f64x3_mag((f64x3) {a, b, c}))));
+      n4 = fmax(n4, rel4(f64x4_norm_fast((f64x4) {a, b, c, a}),
+                         f64x4_divf((f64x4) {a, b, c, a},
+                                    f64x4_mag((f64x4) {a, b, c, a}))));
+    }
+  }
+  int bad = 0;
+  bad |= report("f64_rsqrt", rs);
+  bad |= report("f64l_rsqrt", rl);
+  bad |= report("f64x2_norm_fast", n2);
+  bad |= report("f64x3_norm_fast", n3);
+  bad |= report("f64x4_norm_fast", n4);
+  bad |= edges();
+  return bad;
+}
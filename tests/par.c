@@ -0,0 +1,240 @@
+/*
+** par.c | The Sol Vector Library | The SOL_THREADS pool and `_par_n` kernels.
+** https://github.com/davidgarland/sol
+**
+** Every shape of `_par_n` should give the same result as its `_n` form, so
+** one kernel of each is run both ways for several lengths, pool sizes and
+** chunk sizes, down to one element a chunk so that the edges land everywhere.
+** The inputs are small integers, so even the float reductions are exact in
+** any order and everything compares with `memcmp` or `==`. After that come
+** `sol_par_for` called from inside a job, `sol_threads_set` called from
+** inside a job, and several threads running jobs at once. Run it with
+** `make par`, which builds it with ThreadSanitizer.
+*/
+
+#include <stdio.h>
+#include "../sol.h"
+
+#define N 1001
+
+static size_t bad;
+
+/*
+** The buffers are unions, so each check can write through whichever type its
+** kernel takes and then compare the bytes.
+*/
+
+typedef union {
+  f32 f[16 * N];
+  i32 i[16 * N];
+  u8 b[64 * N];
+  f16 h[32 * N];
+  f32x3 v3[4 * N];
+  f32x4 v4[4 * N];
+  f32x3p p[4 * N];
+  f16x4 h4[4 * N];
+  i32x4 i4[4 * N];
+} buf;
+
+static buf in1, in2, in3, in4, o1, o2;
+
+#define SAME(F, X, Y) {                                             \
+  if (memcmp(&X, &Y, sizeof X)) {                                   \
+    printf(F " n=%zu threads=%d chunk=%zu\n", n, sol_threads_get(), \
+           sol_chunk_get(n));                                       \
+    bad++;                                                          \
+  }                                                                 \
+}
+
+/*
+** CHECK runs `F_n` into `o1` and `F_par_n` into `o2`, both cleared first,
+** with the output `O` and then the other arguments.
+*/
+
+#define CHECK(F, O, ...) {         \
+  memset(&o1, 0, sizeof o1);       \
+  memset(&o2, 0, sizeof o2);       \
+  F##_n(o1.O, __VA_ARGS__, n);     \
+  F##_par_n(o2.O, __VA_ARGS__, n); \
+  SAME(#F, o1, o2)                 \
+}
+
+#define CHECK_R(F, ...) {                                            \
+  if (F##_n(__VA_ARGS__, n) != F##_par_n(__VA_ARGS__, n)) {          \
+    printf(#F " n=%zu threads=%d chunk=%zu\n", n, sol_threads_get(), \
+           sol_chunk_get(n));                                        \
+    bad++;                                                           \
+  }                                                                  \
+}
+
+static void kernels(size_t n) {
+  const f32 c[4] = {3, -1, 2, 1};
+  const f32x4x4 m = f32x4x4_set(f32x4_set(1, 2, 0, 0), f32x4_set(0, 1, 3, 0),
+                                f32x4_set(2, 0, 1, 0), f32x4_set(1, 1, 1, 1));
+  CHECK(f32x4_sq, v4, in1.v4)
+  CHECK(f32x4_add, v4, in1.v4, in2.v4)
+  CHECK(f32x4_addf, v4, in1.v4, 3)
+  CHECK(f32x4_fsub, v4, 3, in1.v4)
+  CHECK(f32x4_fma, v4, in1.v4, in2.v4, in3.v4)
+  CHECK(f32x4_qrot, v3, in1.v4, in2.v3)
+  CHECK(f32x4_qnlerp, v4, in1.v4, in2.v4, 0.25f)
+  CHECK(f32x4x4_mulv, v4, m, in1.v4)
+  CHECK(i32x4_div_by, i4, in4.i4, i32div_set(7))
+  CHECK(f32_rsqrt, f, in1.f)
+  CHECK(f32_to_f16, h, in1.f)
+  CHECK(f16_to_f32, f, in3.h)
+  CHECK(f32x4_to_f16, h4, in1.v4)
+  CHECK(f32x3_pack, p, in1.v3)
+  CHECK(f32x3_unpack, v3, in2.p)
+  CHECK(f32_poly, f, in1.f, c, 3)
+  CHECK(f32x4_poly, v4, in1.v4, c, 3)
+  CHECK(f32_interleave2, f, in1.f, in2.f)
+  CHECK(f32_interleave3, f, in1.f, in2.f, in3.f)
+  CHECK(u8_interleave4, b, in1.b, in2.b, in3.b, in4.b)
+
+  memset(&o1, 0, sizeof o1);
+  memset(&o2, 0, sizeof o2);
+  u8_deinterleave3_n(o1.b, o1.b + N, o1.b + 2 * N, in4.b, n);
+  u8_deinterleave3_par_n(o2.b, o2.b + N, o2.b + 2 * N, in4.b, n);
+  f32_deinterleave4_n(o1.f + 4 * N, o1.f + 5 * N, o1.f + 6 * N, o1.f + 7 * N,
+                      in1.f, n);
+  f32_deinterleave4_par_n(o2.f + 4 * N, o2.f + 5 * N, o2.f + 6 * N,
+                          o2.f + 7 * N, in1.f, n);
+  SAME("deinterleave", o1, o2)
+
+  CHECK_R(f32_sum, in1.f)
+  CHECK_R(f32_dot, in1.f, in2.f)
+  CHECK_R(f32_min, in1.f)
+  CHECK_R(f32_max, in1.f)
+  CHECK_R(f32_sum_precise, in1.f)
+  CHECK_R(f32_dot_precise, in1.f, in2.f)
+  CHECK_R(i32_sum, in4.i)
+  CHECK_R(u8_max, in4.b)
+
+  f32 lo1, hi1, lo2, hi2;
+  f32_minmax_n(&lo1, &hi1, in2.f, n);
+  f32_minmax_par_n(&lo2, &hi2, in2.f, n);
+  if (lo1 != lo2 || hi1 != hi2) {
+    printf("f32_minmax n=%zu threads=%d chunk=%zu\n", n, sol_threads_get(),
+           sol_chunk_get(n));
+    bad++;
+  }
+}
+
+/*
+** A job that calls `sol_par_for` for each of its rows, and on row 0 also
+** resizes the pool. Each cell should be visited exactly once.
+*/
+
+#define ROWS 64
+#define COLS 96
+
+static int cell[ROWS][COLS];
+
+static void inner(void* ctx, size_t lo, size_t hi) {
+  int* row = (int*) ctx;
+  for (size_t i = lo; i < hi; i++)
+    row[i]++;
+}
+
+static void outer(void* ctx, size_t lo, size_t hi) {
+  (void) ctx;
+  for (size_t r = lo; r < hi; r++) {
+    if (r == 0)
+      sol_threads_set(3);
+    sol_par_for(COLS, inner, cell[r]);
+  }
+}
+
+static void nested(void) {
+  memset(cell, 0, sizeof cell);
+  sol_threads_set(4);
+  sol_chunk_set(5);
+  sol_par_for(ROWS, outer, NULL);
+  for (size_t r = 0; r < ROWS; r++)
+    for (size_t i = 0; i < COLS; i++)
+      if (cell[r][i] != 1) {
+        printf("nested: cell %zu %zu visited %d times\n", r, i, cell[r][i]);
+        bad++;
+      }
+  if (sol_threads_get() != 3) {
+    printf("nested: %d threads after sol_threads_set(3)\n", sol_threads_get());
+    bad++;
+  }
+}
+
+/*
+** Several threads run jobs on their own arrays at once, while the last one
+** keeps changing the pool and chunk sizes under them.
+*/
+
+#define CALLERS 4
+#define LEN 4001
+
+typedef struct {
+  f32x4 a[LEN], b[LEN], want[LEN], got[LEN];
+  i32 v[LEN];
+  size_t bad;
+} caller;
+
+static caller callers[CALLERS];
+
+static void* call(void* arg) {
+  caller* c = (caller*) arg;
+  for (size_t k = 0; k < 30; k++) {
+    if (c == &callers[CALLERS - 1]) {
+      sol_threads_set(1 + (int) k % 5);
+      sol_chunk_set(k % 3 ? 7 + k : 0);
+    }
+    f32x4_add_par_n(c->got, c->a, c->b, LEN);
+    if (memcmp(c->got, c->want, sizeof c->got))
+      c->bad++;
+    if (i32_sum_par_n(c->v, LEN) != (i32) (LEN * (LEN - 1) / 2))
+      c->bad++;
+  }
+  return NULL;
+}
+
+static void concurrent(void) {
+  pthread_t th[CALLERS];
+  for (size_t t = 0; t < CALLERS; t++) {
+    caller* c = &callers[t];
+    for (size_t i = 0; i < LEN; i++) {
+      c->a[i] = f32x4_setf((f32) (i % 50 + t));
+      c->b[i] = f32x4_setf((f32) (i % 7));
+      c->v[i] = (i32) i;
+    }
+    f32x4_add_n(c->want, c->a, c->b, LEN);
+    pthread_create(&th[t], NULL, call, c);
+  }
+  for (size_t t = 0; t < CALLERS; t++) {
+    pthread_join(th[t], NULL);
+    if (callers[t].bad) {
+      printf("concurrent: caller %zu had %zu bad results\n", t, callers[t].bad);
+      bad++;
+    }
+  }
+}
+
+int main(void) {
+  static const size_t lens[] = {0, 1, 2, 5, 16, 17, 100, N};
+  static const int threads[] = {1, 2, 3, 8};
+  static const size_t chunks[] = {1, 3, 64, 0};
+  for (size_t i = 0; i < sizeof in1.f / sizeof in1.f[0]; i++) {
+    in1.f[i] = (f32) (i % 17);
+    in2.f[i] = (f32) (i * 7 % 13) - 6;
+    in4.i[i] = (i32) (i * 2654435761u);
+  }
+  f32_to_f16_n(in3.h, in2.f, 16 * N);
+  for (size_t t = 0; t < sizeof threads / sizeof threads[0]; t++)
+    for (size_t c = 0; c < sizeof chunks / sizeof chunks[0]; c++) {
+      sol_threads_set(threads[t]);
+      sol_chunk_set(chunks[c]);
+      for (size_t k = 0; k < sizeof lens / sizeof lens[0]; k++)
+        kernels(lens[k]);
+    }
+  nested();
+  concurrent();
+  printf("%zu failures\n", bad);
+  return bad != 0;
+}
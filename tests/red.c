@@ -0,0 +1,63 @@
+/*
+** red.c | The Sol Vector Library | NaN handling in the min/max reductions.
+** https://github.com/davidgarland/sol
+**
+** `T_min_n`, `T_max_n` and `T_minmax_n` should skip NaN elements, so for each
+** length and each position of a single NaN this checks them against a plain
+** loop that does. Every other element is at least 11 and one is 1 (or 21
+** for max), so a NaN that wipes out an accumulator lane shows up as the
+** wrong extreme. Run it with `make red`, and with `CFLAGS=-mavx2` for the
+** wider accumulators.
+*/
+
+#include <stdio.h>
+#include "../sol.h"
+
+#define N 300
+
+static f32 v32[N];
+static f64 v64[N];
+
+/*
+** `want` is the plain loop: `<` and `>` are false against NaN, so it is
+** skipped.
+*/
+
+#define WANT(V, N, OP, INIT) {           \
+  want = INIT;                           \
+  for (size_t i = 0; i < N; i++)         \
+    want = (V[i] OP want) ? V[i] : want; \
+}
+
+#define CHECK(T, V) {                                                      \
+  for (size_t n = 1; n <= N; n += (n < 80) ? 1 : 37)                       \
+    for (size_t nan = 0; nan < n; nan++)                                   \
+      for (size_t ext = 0; ext < n; ext += 1 + n / 8) {                    \
+        if (ext == nan)                                                    \
+          continue;                                                        \
+        for (size_t i = 0; i < n; i++)                                     \
+          V[i] = (T) (11 + (T) (i % 7) / 2);                               \
+        V[ext] = 1;                                                        \
+        V[nan] = (T) NAN;                                                  \
+        T lo, hi, want;                                                    \
+        T##_minmax_n(&lo, &hi, V, n);                                      \
+        const T min = T##_min_n(V, n);                                     \
+        WANT(V, n, >, (T) -INFINITY)                                    \
+        const T whi = want;                                                \
+        V[ext] = 21;                                                       \
+        const T max = T##_max_n(V, n);                                     \
+        if (min != 1 || max != 21 || lo != 1 || hi != whi) {               \
+          printf(#T " n=%zu nan=%zu ext=%zu: min %g max %g lo %g hi %g\n", \
+                 n, nan, ext, (f64) min, (f64) max, (f64) lo, (f64) hi);   \
+          bad++;                                                           \
+        }                                                                  \
+      }                                                                    \
+}
+
+int main(void) {
+  size_t bad = 0;
+  CHECK(f32, v32)
+  CHECK(f64, v64)
+  printf("%zu failures\n", bad);
+  return bad != 0;
+}
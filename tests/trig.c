@@ -0,0 +1,257 @@
+/*
+** trig.c | The Sol Vector Library | Trig accuracy and speed per tier.
+** https://github.com/davidgarland/sol
+**
+** For each tier (and the inverse functions) this prints the max error in ULP and absolute terms against a
+** wider reference (f64 libm for f32, long double libm for f64) and the time
+** per call. Run it with `make trig`. The ULP error of the `_fast` and `_mid`
+** tiers is dominated by results near zero, so read the absolute column there.
+** Last it checks that sin and cos stay in [-1, 1] over the whole finite range,
+** and fails if they do not.
+*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../sol.h"
+
+#define N (1 << 20)
+
+static f32 in32[N], in32b[N], out32[N];
+static f64 in64[N], in64b[N], out64[N];
+static volatile f64 sink;
+
+static f64 now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (f64) ts.tv_sec * 1e9 + (f64) ts.tv_nsec;
+}
+
+static f64 ulp32(f64 ref) {
+  const f32 r = fabsf((f32) ref);
+  return (f64) (nextafterf(r, INFINITY) - r);
+}
+
+static f64 ulp64(long double ref) {
+  const f64 r = fabs((f64) ref);
+  return nextafter(r, INFINITY) - r;
+}
+
+static void fill(f64 range) {
+  srand(1);
+  for (size_t i = 0; i < N; i++) {
+    in64[i] = ((f64) rand() / RAND_MAX * 2 - 1) * range;
+    in64b[i] = ((f64) rand() / RAND_MAX * 2 - 1) * range;
+    in32[i] = (f32) in64[i];
+    in32b[i] = (f32) in64b[i];
+  }
+}
+
+/*
+** `F` is timed with the calls inlined into the loop, then checked against
+** `R`. tan is skipped near its poles, where ULP error means nothing. `A` and
+** `B` pick the arguments, so the same macros cover atan2.
+*/
+
+#define BENCH32(NAME, F, R, A, B) {                                          \
+  f64 t = now(), acc = 0, ulp = 0, abs = 0;                            \
+  for (size_t i = 0; i < N; i++)                                       \
+    acc += (f64) F(A(in32[i], in32b[i]));                              \
+  t = (now() - t) / N;                                                 \
+  sink = acc;                                                          \
+  for (size_t i = 0; i < N; i++) {                                     \
+    const f64 ref = R(A((f64) in32[i], (f64) in32b[i]));               \
+    const f64 err = fabs((f64) F(A(in32[i], in32b[i])) - ref);         \
+    if (fabs(ref) > 1e4)                                               \
+      continue;                                                        \
+    abs = (err > abs) ? err : abs;                                     \
+    ulp = (err / ulp32(ref) > ulp) ? err / ulp32(ref) : ulp;           \
+  }                                                                    \
+  printf("%-18s %8.2f ns %14.2f ulp %12.3e abs\n", NAME, t, ulp, abs); \
+}
+
+#define BENCH64(NAME, F, R, A, B) {                                          \
+  f64 t = now(), acc = 0, ulp = 0, abs = 0;                                      \
+  for (size_t i = 0; i < N; i++)                                                 \
+    acc += F(A(in64[i], in64b[i]));                                              \
+  t = (now() - t) / N;                                                           \
+  sink = acc;                                                                    \
+  for (size_t i = 0; i < N; i++) {                                               \
+    const long double ref = R(A((long double) in64[i], (long double) in64b[i])); \
+    const f64 err = (f64) fabsl((long double) F(A(in64[i], in64b[i])) - ref);    \
+    if (fabsl(ref) > 1e4)                                                        \
+      continue;                                                                  \
+    abs = (err > abs) ? err : abs;                                               \
+    ulp = (err / ulp64(ref) > ulp) ? err / ulp64(ref) : ulp;                     \
+  }                                                                              \
+  printf("%-18s %8.2f ns %14.2f ulp %12.3e abs\n", NAME, t, ulp, abs);           \
+}
+
+/*
+** The lane versions are timed per element over whole arrays, the way the SoA
+** stream kernels use them.
+*/
+
+#define BENCHL(NAME, T, L, F, R, A, B) {                                   \
+  f64 t = now(), ulp = 0, abs = 0;                                                   \
+  for (size_t i = 0; i < N; i += L##_w)                                              \
+    L##_store(out##T + i, F(A(L##_load(in##T + i), L##_load(in##T##b + i))));        \
+  t = (now() - t) / N;                                                               \
+  for (size_t i = 0; i < N; i++) {                                                   \
+    const long double ref = R(A((long double) in##T[i], (long double) in##T##b[i])); \
+    const f64 err = (f64) fabsl((long double) out##T[i] - ref);                      \
+    const f64 u = (sizeof(in##T[0]) == 4) ? ulp32((f64) ref) : ulp64(ref);           \
+    if (fabsl(ref) > 1e4)                                                            \
+      continue;                                                                      \
+    abs = (err > abs) ? err : abs;                                                   \
+    ulp = (err / u > ulp) ? err / u : ulp;                                           \
+  }                                                                                  \
+  printf("%-18s %8.2f ns %14.2f ulp %12.3e abs\n", NAME, t, ulp, abs);               \
+}
+
+#define ONE(a, b) a
+#define TWO(a, b) a, b
+
+static void run(f64 range) {
+  fill(range);
+  printf("\n|x| <= %g\n", range);
+  BENCH32("f32_sin (libm)", sinf, sin, ONE, _)
+  BENCH32("f32_sin_fast", f32_sin_fast, sin, ONE, _)
+  BENCH32("f32_sin_mid", f32_sin_mid, sin, ONE, _)
+  BENCH32("f32_sin_precise", f32_sin_precise, sin, ONE, _)
+  BENCH32("f32_cos (libm)", cosf, cos, ONE, _)
+  BENCH32("f32_cos_fast", f32_cos_fast, cos, ONE, _)
+  BENCH32("f32_cos_mid", f32_cos_mid, cos, ONE, _)
+  BENCH32("f32_cos_precise", f32_cos_precise, cos, ONE, _)
+  BENCH32("f32_tan (libm)", tanf, tan, ONE, _)
+  BENCH32("f32_tan_fast", f32_tan_fast, tan, ONE, _)
+  BENCH32("f32_tan_mid", f32_tan_mid, tan, ONE, _)
+  BENCH32("f32_tan_precise", f32_tan_precise, tan, ONE, _)
+  BENCH64("f64_sin (libm)", sin, sinl, ONE, _)
+  BENCH64("f64_sin_fast", f64_sin_fast, sinl, ONE, _)
+  BENCH64("f64_sin_mid", f64_sin_mid, sinl, ONE, _)
+  BENCH64("f64_sin_precise", f64_sin_precise, sinl, ONE, _)
+  BENCH64("f64_cos (libm)", cos, cosl, ONE, _)
+  BENCH64("f64_cos_fast", f64_cos_fast, cosl, ONE, _)
+  BENCH64("f64_cos_mid", f64_cos_mid, cosl, ONE, _)
+  BENCH64("f64_cos_precise", f64_cos_precise, cosl, ONE, _)
+  BENCH64("f64_tan (libm)", tan, tanl, ONE, _)
+  BENCH64("f64_tan_fast", f64_tan_fast, tanl, ONE, _)
+  BENCH64("f64_tan_mid", f64_tan_mid, tanl, ONE, _)
+  BENCH64("f64_tan_precise", f64_tan_precise, tanl, ONE, _)
+  BENCHL("f32l_sin", 32, f32l, f32l_sin, sinl, ONE, _)
+  BENCHL("f32l_cos", 32, f32l, f32l_cos, cosl, ONE, _)
+  BENCHL("f64l_sin", 64, f64l, f64l_sin, sinl, ONE, _)
+  BENCHL("f64l_cos", 64, f64l, f64l_cos, cosl, ONE, _)
+}
+
+static void run_inverse(f64 range) {
+  fill(range);
+  printf("\n|x| <= %g\n", range);
+  if (range <= 1) {
+    BENCH32("f32_asin (libm)", asinf, asin, ONE, _)
+    BENCH32("f32_asin", f32_asin, asin, ONE, _)
+    BENCH32("f32_acos (libm)", acosf, acos, ONE, _)
+    BENCH32("f32_acos", f32_acos, acos, ONE, _)
+    BENCH64("f64_asin (libm)", asin, asinl, ONE, _)
+    BENCH64("f64_asin", f64_asin, asinl, ONE, _)
+    BENCH64("f64_acos (libm)", acos, acosl, ONE, _)
+    BENCH64("f64_acos", f64_acos, acosl, ONE, _)
+    BENCHL("f32l_asin", 32, f32l, f32l_asin, asinl, ONE, _)
+    BENCHL("f32l_acos", 32, f32l, f32l_acos, acosl, ONE, _)
+    BENCHL("f64l_asin", 64, f64l, f64l_asin, asinl, ONE, _)
+    BENCHL("f64l_acos", 64, f64l, f64l_acos, acosl, ONE, _)
+  }
+  BENCH32("f32_atan (libm)", atanf, atan, ONE, _)
+  BENCH32("f32_atan", f32_atan, atan, ONE, _)
+  BENCH32("f32_atan2 (libm)", atan2f, atan2, TWO, _)
+  BENCH32("f32_atan2", f32_atan2, atan2, TWO, _)
+  BENCH64("f64_atan (libm)", atan, atanl, ONE, _)
+  BENCH64("f64_atan", f64_atan, atanl, ONE, _)
+  BENCH64("f64_atan2 (libm)", atan2, atan2l, TWO, _)
+  BENCH64("f64_atan2", f64_atan2, atan2l, TWO, _)
+  BENCHL("f32l_atan", 32, f32l, f32l_atan, atanl, ONE, _)
+  BENCHL("f32l_atan2", 32, f32l, f32l_atan2, atan2l, TWO, _)
+  BENCHL("f64l_atan", 64, f64l, f64l_atan, atanl, ONE, _)
+  BENCHL("f64l_atan2", 64, f64l, f64l_atan2, atan2l, TWO, _)
+}
+
+/*
+** Every tier has to stay in [-1, 1] for every finite argument, however far
+** past its accurate range. The arguments are random bit patterns, so they
+** cover each exponent about equally.
+*/
+
+#define BOUND32(F) {                                                 \
+  size_t bad = 0;                                                    \
+  for (size_t i = 0; i < N; i++)                                     \
+    bad += !(fabsf(F(in32[i])) <= 1);                                \
+  printf("%-18s %8zu of %zu out of [-1, 1]\n", #F, bad, (size_t) N); \
+  fails += bad;                                                      \
+}
+
+#define BOUND64(F) {                                                 \
+  size_t bad = 0;                                                    \
+  for (size_t i = 0; i < N; i++)                                     \
+    bad += !(fabs(F(in64[i])) <= 1);                                 \
+  printf("%-18s %8zu of %zu out of [-1, 1]\n", #F, bad, (size_t) N); \
+  fails += bad;                                                      \
+}
+
+#define BOUNDL(T, L, F) {                                            \
+  size_t bad = 0;                                                    \
+  for (size_t i = 0; i < N; i += L##_w)                              \
+    L##_store(out##T + i, F(L##_load(in##T + i)));                   \
+  for (size_t i = 0; i < N; i++)                                     \
+    bad += !(fabs((f64) out##T[i]) <= 1);                            \
+  printf("%-18s %8zu of %zu out of [-1, 1]\n", #F, bad, (size_t) N); \
+  fails += bad;                                                      \
+}
+
+static size_t bound(void) {
+  size_t fails = 0;
+  srand(1);
+  for (size_t i = 0; i < N; i++) {
+    u32 u = 0;
+    u64 v = 0;
+    do {
+      for (size_t j = 0; j < 4; j++)
+        u = (u << 8) | (u32) (rand() & 0xff);
+      memcpy(&in32[i], &u, sizeof u);
+    } while (!isfinite(in32[i]));
+    do {
+      for (size_t j = 0; j < 8; j++)
+        v = (v << 8) | (u64) (rand() & 0xff);
+      memcpy(&in64[i], &v, sizeof v);
+    } while (!isfinite(in64[i]));
+  }
+  printf("\nall finite x\n");
+  BOUND32(f32_sin_fast)
+  BOUND32(f32_cos_fast)
+  BOUND32(f32_sin_mid)
+  BOUND32(f32_cos_mid)
+  BOUND32(f32_sin_precise)
+  BOUND32(f32_cos_precise)
+  BOUND64(f64_sin_fast)
+  BOUND64(f64_cos_fast)
+  BOUND64(f64_sin_mid)
+  BOUND64(f64_cos_mid)
+  BOUND64(f64_sin_precise)
+  BOUND64(f64_cos_precise)
+  BOUNDL(32, f32l, f32l_sin)
+  BOUNDL(32, f32l, f32l_cos)
+  BOUNDL(64, f64l, f64l_sin)
+  BOUNDL(64, f64l, f64l_cos)
+  return fails;
+}
+
+int main(void) {
+  run(f64_pi);
+  run(1e3);
+  run(1e6);
+  run_inverse(1);
+  run_inverse(1e3);
+  return bound() != 0;
+}